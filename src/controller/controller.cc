@@ -1,12 +1,43 @@
 #include "controller.h"
 
+#include <QCoreApplication>
 #include <memory>
+#include <utility>
 
 #include "model/reader/reader_emnist.h"
 
 namespace s21 {
 
-Controller::Controller() : window_(), model_() {}
+namespace {
+
+// Режим обучения окна на время вызова, в том числе при исключении
+class LearningGuard {
+ public:
+  explicit LearningGuard(MainWindow &window) : window_(window) {
+    window_.SetLearning(true);
+  }
+  LearningGuard(const LearningGuard &) = delete;
+  LearningGuard &operator=(const LearningGuard &) = delete;
+  ~LearningGuard() { window_.SetLearning(false); }
+
+ private:
+  MainWindow &window_;
+};
+
+}  // namespace
+
+Controller::Controller()
+    : window_(),
+      model_(),
+      dispatcher_(model_),
+      events_timer_(),
+      validation_(false) {
+  model_.SetSnapshotPeriod(snapshot_period);
+  QObject::connect(&dispatcher_, &InferenceDispatcher::Answered, &window_,
+                   &MainWindow::UpdateLettersAnswer, Qt::QueuedConnection);
+  QObject::connect(&dispatcher_, &InferenceDispatcher::Answered, &window_,
+                   &MainWindow::ShowInferenceLatency, Qt::QueuedConnection);
+}
 
 Controller &Controller::GetInstance() {
   static std::unique_ptr<Controller> instance(new Controller());
@@ -17,6 +48,10 @@ void Controller::SaveWeights(std::string path) const {
   model_.SaveWeights(path);
 }
 
+void Controller::SaveBinaryWeights(const std::string &path) const {
+  model_.SaveBinaryWeights(path);
+}
+
 void Controller::LoadWeights(std::string path) { model_.LoadWeights(path); }
 
 void Controller::SetMatrixNetwork() { model_.SetMatrixNetwork(); }
@@ -27,6 +62,10 @@ void Controller::SetGraphNetwork() { model_.SetGraphNetwork(); }
 
 bool Controller::IsGraphNetwork() const { return model_.IsGraphNetwork(); }
 
+void Controller::SetStaticNetwork() { model_.SetStaticNetwork(); }
+
+bool Controller::IsStaticNetwork() const { return model_.IsStaticNetwork(); }
+
 void Controller::SetLearningRate(const float learning_rate) {
   model_.SetLearningRate(learning_rate);
 }
@@ -49,6 +88,15 @@ std::size_t Controller::GetCountNeurons() const {
   return model_.GetCountNeurons();
 }
 
+void Controller::SetHiddenLayers(
+    const std::vector<std::size_t> &hidden_layers) {
+  model_.SetHiddenLayers(hidden_layers);
+}
+
+const std::vector<std::size_t> &Controller::GetHiddenLayers() const {
+  return model_.GetHiddenLayers();
+}
+
 void Controller::SetCountEpoch(const std::size_t count_epoch) {
   model_.SetCountEpoch(count_epoch);
 }
@@ -67,26 +115,109 @@ void Controller::SetKValid(const std::size_t k_valid) {
 
 std::size_t Controller::GetKValid() const { return model_.GetKValid(); }
 
-void Controller::Learn(std::string path) {
+void Controller::SetValidation(const bool validation) {
+  validation_ = validation;
+}
+
+bool Controller::IsValidation() const { return validation_; }
+
+void Controller::SetValidationOptions(
+    const Model::ValidationOptions &options) {
+  model_.SetValidationOptions(options);
+}
+
+Model::ValidationOptions Controller::GetValidationOptions() const {
+  return model_.GetValidationOptions();
+}
+
+Controller::LearnOutput Controller::Learn(std::string path,
+                                          std::string validation_path) {
   ReaderEMNIST learn_values{path};
   if (learn_values.Size() == 0) {
-    return;
+    return {};
+  }
+  LearnOutput output;
+  const LearningGuard guard(window_);
+  const auto observe = [this](const double mse) { return ObserveLearn(mse); };
+  if (!validation_path.empty()) {
+    ReaderEMNIST validation_values{validation_path};
+    if (validation_values.Size() != 0) {
+      window_.BeginGraphMse();
+      output.fit = model_.Fit(learn_values, validation_values, observe);
+      window_.SetValidationMse(output.fit->validation_steps,
+                               output.fit->validation_mse);
+      window_.EndGraphMse();
+      return output;
+    }
+  }
+  window_.BeginGraphMse();
+  model_.Train(learn_values, observe);
+  window_.EndGraphMse();
+  return output;
+}
+
+std::optional<Model::CrossValidationOutput> Controller::CrossValidation(
+    std::string path) {
+  ReaderEMNIST learn_values{path};
+  if (learn_values.Size() == 0) {
+    return std::nullopt;
   }
-  for (std::size_t index = 0; index < model_.GetCountEpoch(); ++index) {
-    window_.AddGraphMse(model_.Learn(learn_values));
+  return model_.CrossValidation(learn_values);
+}
+
+void Controller::SetCheckpoint(std::string path) {
+  model_.SetCheckpoint(std::move(path), checkpoint_period);
+}
+
+void Controller::Resume(std::string checkpoint_path, std::string path) {
+  ReaderEMNIST learn_values{path};
+  if (learn_values.Size() == 0) {
+    return;
   }
+  model_.Resume(std::move(checkpoint_path));
+  const LearningGuard guard(window_);
+  window_.BeginGraphMse();
+  model_.Train(learn_values,
+               [this](const double mse) { return ObserveLearn(mse); });
+  window_.EndGraphMse();
 }
 
 Model::TestOutput Controller::Test(std::string path) {
-  return model_.Test(ReaderEMNIST(path));
+  ReaderEMNIST test_values{path};
+  return model_.Test(test_values);
 }
 
 void Controller::ForwardFeed(const Matrix<float> &line) {
-  window_.UpdateLettersAnswer(model_.ForwardFeed(line));
+  dispatcher_.Submit(line);
+}
+
+InferenceDispatcher::Latency Controller::GetInferenceLatency() const {
+  return dispatcher_.GetLatency();
+}
+
+Profiler::Stats Controller::GetProfile() const { return Model::GetProfile(); }
+
+void Controller::ResetProfile() { Model::ResetProfile(); }
+
+void Controller::StartTrace() { Model::StartTrace(); }
+
+void Controller::SaveTrace(const std::string &path) { Model::SaveTrace(path); }
+
+bool Controller::ObserveLearn(const double mse) {
+  window_.AddMse(mse);
+  if (!events_timer_.isValid() ||
+      events_timer_.elapsed() >= events_interval_ms) {
+    QCoreApplication::processEvents();
+    events_timer_.start();
+  }
+  return !window_.IsCloseRequested();
 }
 
 void Controller::ShowWindow() { window_.show(); }
 
-void Controller::ClearWindow() { window_.clearTableAnswers(); }
+void Controller::ClearWindow() {
+  dispatcher_.Cancel();
+  window_.clearTableAnswers();
+}
 
 }  // namespace s21
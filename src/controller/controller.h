@@ -1,7 +1,10 @@
 #pragma once
 
+#include <QElapsedTimer>
 #include <functional>
+#include <optional>
 
+#include "inference_dispatcher.h"
 #include "model/model.h"
 #include "qclass/main_window/main_window.h"
 
@@ -10,6 +13,17 @@ namespace s21 {
 //! Контроллер приложения
 class Controller {
  public:
+  //! Период контрольных точек в обучающих примерах
+  static constexpr std::size_t checkpoint_period = 8192;
+  //! Период публикации весов для распознавания во время обучения
+  static constexpr std::size_t snapshot_period = 512;
+  //! Интервал обработки событий GUI во время обучения в миллисекундах
+  static constexpr qint64 events_interval_ms = 30;
+  //! Структура вывода обучения
+  struct LearnOutput {
+    //! Результат обучения с валидацией, если задана валидационная выборка
+    std::optional<Model::FitOutput> fit;
+  };
   //! Получить Instance контроллера
   static Controller &GetInstance();
   /**
@@ -17,7 +31,11 @@ class Controller {
    */
   void SaveWeights(std::string) const;
   /**
-   * @brief Загрузить веса из файла в модель
+   * @brief Сохранить веса модели в бинарный файл
+   */
+  void SaveBinaryWeights(const std::string &) const;
+  /**
+   * @brief Загрузить веса из текстового или бинарного файла в модель
    */
   void LoadWeights(std::string);
   //! Установить матричную сеть
@@ -28,18 +46,26 @@ class Controller {
   void SetGraphNetwork();
   //! Узнать графовая ли сеть
   bool IsGraphNetwork() const;
+  //! Установить статическую матричную сеть
+  void SetStaticNetwork();
+  //! Узнать статическая ли сеть
+  bool IsStaticNetwork() const;
   //! Установить скорость обучения
   void SetLearningRate(float);
   //! Получить скорость обучения
   float GetLearningRate() const;
-  //! Установить количество слоев
+  //! Установить количество скрытых слоев
   void SetCountLayers(std::size_t);
-  //! Получить количество слоев
+  //! Получить количество скрытых слоев
   std::size_t GetCountLayers() const;
-  //! Установить количество нейронов в слою
+  //! Установить одинаковое количество нейронов во всех скрытых слоях
   void SetCountNeurons(std::size_t);
-  //! Получить количество нейронов в слою
+  //! Получить количество нейронов в первом скрытом слое
   std::size_t GetCountNeurons() const;
+  //! Установить размеры скрытых слоев
+  void SetHiddenLayers(const std::vector<std::size_t> &);
+  //! Получить размеры скрытых слоев
+  const std::vector<std::size_t> &GetHiddenLayers() const;
   //! Установить количество эпох обучения
   void SetCountEpoch(std::size_t);
   //! Получить количество эпох обучения
@@ -52,11 +78,42 @@ class Controller {
   void SetKValid(std::size_t);
   //! Получить количество количество к-валидации
   std::size_t GetKValid() const;
+  //! Включить или выключить валидацию во время обучения
+  void SetValidation(bool);
+  //! Узнать включена ли валидация во время обучения
+  bool IsValidation() const;
+  //! Установить параметры валидации во время обучения
+  void SetValidationOptions(const Model::ValidationOptions &);
+  //! Получить параметры валидации во время обучения
+  Model::ValidationOptions GetValidationOptions() const;
   /**
    * @brief Обучить модель
+   * @details Если задана валидационная выборка, обучение идет с
+   * периодической валидацией и ранней остановкой
+   * @param path Путь до обучающей выборки
+   * @param validation_path Путь до валидационной выборки
+   * @return Результат валидации, если она проводилась
+   */
+  LearnOutput Learn(std::string path, std::string validation_path = "");
+  /**
+   * @brief Провести k-блочную кросс-валидацию на копиях модели
+   * @details Число блоков задается SetKValid, веса модели не меняются
+   * @param path Путь до обучающей выборки
+   * @return Метрики по блокам, пустой результат для пустой выборки
+   */
+  std::optional<Model::CrossValidationOutput> CrossValidation(
+      std::string path);
+  /**
+   * @brief Включить контрольные точки обучения
+   * @param path Путь до файла контрольной точки, пустой выключает их
+   */
+  void SetCheckpoint(std::string path);
+  /**
+   * @brief Продолжить обучение с контрольной точки
+   * @param checkpoint_path Путь до файла контрольной точки
    * @param path Путь до обучающей выборки
    */
-  void Learn(std::string path);
+  void Resume(std::string checkpoint_path, std::string path);
   /**
    * @brief Протестировать модель
    * @param path Путь до тестовой выборки
@@ -64,10 +121,21 @@ class Controller {
   Model::TestOutput Test(std::string path);
   /**
    * @brief Обработать входные сенсоры
-   * @details Ответы отправляет в обработчик основного окна
+   * @details Ставит сенсоры в очередь диспетчера распознавания, ответы
+   * асинхронно приходят в обработчик основного окна
    * @param sensors Входные сенсоры
    */
   void ForwardFeed(const Matrix<float> &sensors);
+  //! Получить статистику задержек распознавания
+  InferenceDispatcher::Latency GetInferenceLatency() const;
+  //! Получить таймеры фаз обучения и счетчики памяти
+  Profiler::Stats GetProfile() const;
+  //! Обнулить таймеры фаз обучения
+  void ResetProfile();
+  //! Начать запись отрезков выполнения
+  void StartTrace();
+  //! Закончить запись отрезков и сохранить их в файл
+  void SaveTrace(const std::string &path);
   //! Показать основное окно
   void ShowWindow();
   //! Очистить основное окно
@@ -76,10 +144,26 @@ class Controller {
  private:
   //! Дефолтный конструктор
   Controller();
+  /**
+   * @brief Передать ошибку примера в график и обработать события GUI
+   * @details Пока идет обучение, окно остается отзывчивым, а нарисованные
+   * буквы распознаются по последним опубликованным весам. Меню, меняющие
+   * модель, выключены, поэтому из обработки событий доступны только
+   * распознавание, окно графика и закрытие основного окна
+   * @param mse Ошибка
+   * @return Продолжать ли обучение, false после попытки закрыть окно
+   */
+  bool ObserveLearn(double mse);
   // Основное окно
   MainWindow window_;
   // Модель
   Model model_;
+  // Диспетчер распознавания
+  InferenceDispatcher dispatcher_;
+  // Время с последней обработки событий GUI
+  QElapsedTimer events_timer_;
+  // Спрашивать ли валидационную выборку перед обучением
+  bool validation_;
 };
 
 }  // namespace s21
@@ -0,0 +1,90 @@
+#include "inference_dispatcher.h"
+
+namespace s21 {
+
+InferenceDispatcher::InferenceDispatcher(const Model &model,
+                                         QObject *parent)
+    : QObject(parent),
+      model_(model),
+      pending_(),
+      pending_time_(),
+      has_pending_(false),
+      generation_(0),
+      stop_(false),
+      latency_{},
+      worker_() {
+  qRegisterMetaType<s21::Matrix<float>>();
+  worker_ = std::thread(&InferenceDispatcher::Run, this);
+}
+
+InferenceDispatcher::~InferenceDispatcher() {
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_one();
+  worker_.join();
+}
+
+void InferenceDispatcher::Submit(const Matrix<float> &sensors) {
+  {
+    std::lock_guard lock(mutex_);
+    if (has_pending_) {
+      ++latency_.dropped;
+    }
+    pending_ = sensors;
+    pending_time_ = Clock::now();
+    has_pending_ = true;
+  }
+  condition_.notify_one();
+}
+
+void InferenceDispatcher::Cancel() {
+  std::lock_guard lock(mutex_);
+  has_pending_ = false;
+  ++generation_;
+}
+
+InferenceDispatcher::Latency InferenceDispatcher::GetLatency() const {
+  std::lock_guard lock(mutex_);
+  return latency_;
+}
+
+void InferenceDispatcher::Run() {
+  NetworkReplica replica(model_.GetPublishedNetwork());
+  Matrix<float> sensors;
+  while (true) {
+    Clock::time_point start;
+    std::size_t generation = 0;
+    {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [this] { return stop_ || has_pending_; });
+      if (stop_) {
+        return;
+      }
+      std::swap(sensors, pending_);
+      start = pending_time_;
+      generation = generation_;
+      has_pending_ = false;
+    }
+    const Matrix<float> answers = replica.ForwardFeedIncremental(sensors);
+    const double latency_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    {
+      std::lock_guard lock(mutex_);
+      if (generation != generation_) {
+        continue;
+      }
+      ++latency_.processed;
+      latency_.last_ms = latency_ms;
+      latency_.max_ms = std::max(latency_.max_ms, latency_ms);
+      latency_.average_ms +=
+          (latency_ms - latency_.average_ms) /
+          static_cast<double>(latency_.processed);
+      emit Answered(answers, latency_ms);
+    }
+  }
+}
+
+}  // namespace s21
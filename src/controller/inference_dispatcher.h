@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QObject>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "model/model.h"
+
+namespace s21 {
+
+//! Асинхронный диспетчер распознавания между GUI и моделью
+class InferenceDispatcher : public QObject {
+  Q_OBJECT
+
+ public:
+  //! Статистика задержек распознавания
+  struct Latency {
+    double last_ms, average_ms, max_ms;
+    std::size_t processed, dropped;
+  };
+  /**
+   * @brief Конструктор с запуском рабочего потока
+   * @details Рабочий поток распознает своей копией опубликованного
+   * перцептрона модели и не мешает изменять модель из GUI потока
+   * @param model Модель, перцептрон которой публикуется
+   * @param parent Указатель на родителя
+   */
+  explicit InferenceDispatcher(const Model &model, QObject *parent = nullptr);
+  //! Удален конструктор копирования
+  InferenceDispatcher(const InferenceDispatcher &) = delete;
+  //! Удален оператор копирования
+  InferenceDispatcher &operator=(const InferenceDispatcher &) = delete;
+  //! Деструктор с остановкой рабочего потока
+  ~InferenceDispatcher() override;
+  /**
+   * @brief Поставить сенсоры в очередь на распознавание
+   * @details Хранится только последний запрос, необработанный
+   * предыдущий запрос отбрасывается
+   * @param sensors Входные сенсоры
+   */
+  void Submit(const Matrix<float> &sensors);
+  //! Отбросить ожидающий запрос и ответ на выполняющийся
+  void Cancel();
+  //! Получить статистику задержек
+  Latency GetLatency() const;
+
+ signals:
+  /**
+   * @brief Сигнал готового ответа, доставляется в поток GUI
+   * @param answers Матрица ответов
+   * @param latency_ms Задержка от постановки запроса до ответа
+   */
+  void Answered(const s21::Matrix<float> &answers, double latency_ms);
+
+ private:
+  //! Часы для замера задержек
+  typedef std::chrono::steady_clock Clock;
+  //! Цикл рабочего потока
+  void Run();
+  //! Модель
+  const Model &model_;
+  //! Мьютекс очереди и статистики
+  mutable std::mutex mutex_;
+  //! Условная переменная появления запроса
+  std::condition_variable condition_;
+  //! Последний ожидающий запрос
+  Matrix<float> pending_;
+  //! Время постановки ожидающего запроса
+  Clock::time_point pending_time_;
+  //! Есть ли ожидающий запрос
+  bool has_pending_;
+  //! Поколение запросов, меняется при отмене
+  std::size_t generation_;
+  //! Остановить ли рабочий поток
+  bool stop_;
+  //! Статистика задержек
+  Latency latency_;
+  //! Рабочий поток
+  std::thread worker_;
+};
+
+}  // namespace s21
@@ -0,0 +1,246 @@
+#include "checkpoint.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include "../profiler/profiler.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr char magic[8] = {'S', '2', '1', 'C', 'K', 'P', 'T', '1'};
+
+template <typename T>
+void Write(std::ostream &stream, const T &value) {
+  stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T Read(std::istream &stream) {
+  T value{};
+  stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+  return value;
+}
+
+void WriteOptions(std::ostream &stream, const Augmentation::Options &options) {
+  Write(stream, options.shift);
+  Write(stream, options.rotation);
+  Write(stream, options.shear);
+  Write(stream, options.elastic_alpha);
+  Write(stream, options.elastic_sigma);
+  Write(stream, options.thickness);
+}
+
+Augmentation::Options ReadOptions(std::istream &stream) {
+  Augmentation::Options options;
+  options.shift = Read<float>(stream);
+  options.rotation = Read<float>(stream);
+  options.shear = Read<float>(stream);
+  options.elastic_alpha = Read<float>(stream);
+  options.elastic_sigma = Read<float>(stream);
+  options.thickness = Read<float>(stream);
+  return options;
+}
+
+void WriteMatrix(std::ostream &stream, const Matrix<float> &matrix) {
+  Write<std::uint64_t>(stream, matrix.GetRows());
+  Write<std::uint64_t>(stream, matrix.GetColumns());
+  if (matrix.GetRows() != 0 && matrix.GetColumns() != 0) {
+    stream.write(reinterpret_cast<const char *>(&matrix(0, 0)),
+                 static_cast<std::streamsize>(matrix.GetRows() *
+                                              matrix.GetColumns() *
+                                              sizeof(float)));
+  }
+}
+
+Matrix<float> ReadMatrix(std::istream &stream) {
+  const auto rows = Read<std::uint64_t>(stream),
+             cols = Read<std::uint64_t>(stream);
+  if (!stream || rows == 0 || cols == 0 || rows > (1u << 20) ||
+      cols > (1u << 20)) {
+    throw std::invalid_argument("Bad checkpoint: wrong matrix size.");
+  }
+  Matrix<float> matrix(rows, cols);
+  stream.read(reinterpret_cast<char *>(&matrix(0, 0)),
+              static_cast<std::streamsize>(rows * cols * sizeof(float)));
+  return matrix;
+}
+
+// Сбросить содержимое файла или каталога на диск
+bool Sync(const std::string &path) {
+  const int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+  const bool synced = ::fsync(descriptor) == 0;
+  ::close(descriptor);
+  return synced;
+}
+
+// Каталог файла для сброса записи о переименовании
+std::string Directory(const std::string &path) {
+  const auto slash = path.find_last_of('/');
+  return slash == std::string::npos ? "."
+         : slash == 0               ? "/"
+                                    : path.substr(0, slash);
+}
+
+}  // namespace
+
+void Checkpoint::Save(const std::string &path) const {
+  S21_PROFILE_SCOPE(Serialize);
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream file{tmp_path, std::ios::binary | std::ios::trunc};
+    file.write(magic, sizeof(magic));
+    Write(file, network);
+    Write(file, learning_rate);
+    Write(file, seed);
+    Write<std::uint8_t>(file, shuffle);
+    Write<std::uint8_t>(file, augmentation);
+    WriteOptions(file, augmentation_options);
+    Write(file, epoch);
+    Write(file, skip);
+    Write(file, end_epoch);
+    Write<std::uint64_t>(file, layers.size());
+    for (const auto &[weights, biases] : layers) {
+      WriteMatrix(file, weights);
+      WriteMatrix(file, biases);
+    }
+    file.close();
+    if (!file || !Sync(tmp_path)) {
+      std::remove(tmp_path.c_str());
+      throw std::runtime_error("Can't write checkpoint: " + tmp_path);
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    throw std::runtime_error("Can't replace checkpoint: " + path);
+  }
+  // Не все файловые системы сбрасывают каталоги, сам файл уже на диске
+  Sync(Directory(path));
+}
+
+Checkpoint Checkpoint::Load(const std::string &path) {
+  S21_PROFILE_SCOPE(Serialize);
+  std::ifstream file{path, std::ios::binary};
+  char file_magic[sizeof(magic)] = {};
+  file.read(file_magic, sizeof(file_magic));
+  if (!file || !std::equal(file_magic, file_magic + sizeof(magic), magic)) {
+    throw std::invalid_argument("Bad checkpoint: " + path);
+  }
+  Checkpoint checkpoint;
+  checkpoint.network = Read<std::uint8_t>(file);
+  checkpoint.learning_rate = Read<float>(file);
+  checkpoint.seed = Read<std::uint64_t>(file);
+  checkpoint.shuffle = Read<std::uint8_t>(file) != 0;
+  checkpoint.augmentation = Read<std::uint8_t>(file) != 0;
+  checkpoint.augmentation_options = ReadOptions(file);
+  checkpoint.epoch = Read<std::uint64_t>(file);
+  checkpoint.skip = Read<std::uint64_t>(file);
+  checkpoint.end_epoch = Read<std::uint64_t>(file);
+  const auto size = Read<std::uint64_t>(file);
+  if (!file || size < 2) {
+    throw std::invalid_argument(
+        "The network must have at least one hidden layer.");
+  }
+  for (std::uint64_t index = 0; index < size; ++index) {
+    auto weights = ReadMatrix(file);
+    auto biases = ReadMatrix(file);
+    checkpoint.layers.emplace_back(std::move(weights), std::move(biases));
+  }
+  if (!file) {
+    throw std::invalid_argument("Bad checkpoint: truncated " + path);
+  }
+  return checkpoint;
+}
+
+CheckpointWriter::CheckpointWriter(std::string path)
+    : path_(std::move(path)),
+      pending_(),
+      writing_(false),
+      stop_(false),
+      written_(0),
+      error_(),
+      worker_() {
+  worker_ = std::thread(&CheckpointWriter::Run, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  worker_.join();
+}
+
+void CheckpointWriter::Submit(Checkpoint checkpoint) {
+  {
+    std::lock_guard lock(mutex_);
+    ThrowError();
+    pending_ = std::move(checkpoint);
+  }
+  condition_.notify_all();
+}
+
+void CheckpointWriter::Flush() {
+  std::unique_lock lock(mutex_);
+  condition_.wait(lock, [this] { return !pending_ && !writing_; });
+  ThrowError();
+}
+
+const std::string &CheckpointWriter::GetPath() const { return path_; }
+
+std::size_t CheckpointWriter::GetWritten() const {
+  std::lock_guard lock(mutex_);
+  return written_;
+}
+
+void CheckpointWriter::Run() {
+  while (true) {
+    Checkpoint checkpoint;
+    {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [this] { return stop_ || pending_; });
+      if (!pending_) {
+        return;
+      }
+      checkpoint = std::move(*pending_);
+      pending_.reset();
+      writing_ = true;
+    }
+    std::exception_ptr error;
+    try {
+      checkpoint.Save(path_);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    {
+      std::lock_guard lock(mutex_);
+      writing_ = false;
+      if (error) {
+        error_ = error;
+      } else {
+        ++written_;
+      }
+    }
+    condition_.notify_all();
+  }
+}
+
+void CheckpointWriter::ThrowError() {
+  if (error_) {
+    auto error = std::exchange(error_, nullptr);
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "../loader/augmentation.h"
+#include "../networks/base/base_network.h"
+
+namespace s21 {
+
+/**
+ * @brief Контрольная точка обучения
+ * @details Хранит все, что нужно для побитово точного продолжения обучения:
+ * веса без потери точности, скорость обучения, зерно и параметры загрузчика,
+ * номер эпохи и позицию в ней
+ */
+struct Checkpoint {
+  //! Тип перцептрона: 0 - матричный, 1 - графовый, 2 - статический
+  std::uint8_t network = 0;
+  float learning_rate = 0.f;            //!< Скорость обучения
+  std::uint64_t seed = 0;               //!< Зерно перемешивания и искажений
+  bool shuffle = true;                  //!< Перемешивается ли выборка
+  bool augmentation = false;            //!< Искажаются ли примеры
+  Augmentation::Options augmentation_options;  //!< Параметры искажений
+  std::uint64_t epoch = 0;              //!< Номер текущей эпохи загрузчика
+  std::uint64_t skip = 0;               //!< Пройдено примеров в эпохе
+  std::uint64_t end_epoch = 0;          //!< Номер эпохи окончания обучения
+  BaseNetwork::LayerMatrices layers;    //!< Веса и смещения слоев
+  /**
+   * @brief Атомарно сохранить контрольную точку в бинарный файл
+   * @details Пишет во временный файл рядом, сбрасывает его на диск через
+   * fsync и только потом переименовывает, поэтому после сбоя по пути лежит
+   * целая точка, старая или новая
+   * @param path Путь до файла
+   */
+  void Save(const std::string &path) const;
+  /**
+   * @brief Загрузить контрольную точку из файла
+   * @param path Путь до файла
+   */
+  static Checkpoint Load(const std::string &path);
+};
+
+/**
+ * @brief Фоновая запись контрольных точек
+ * @details Хранит одну ожидающую точку: если новая приходит раньше, чем
+ * записана предыдущая, предыдущая заменяется
+ */
+class CheckpointWriter {
+ public:
+  //! Удален дефолтный конструктор
+  CheckpointWriter() = delete;
+  /**
+   * @brief Конструктор с запуском потока записи
+   * @param path Путь до файла контрольной точки
+   */
+  explicit CheckpointWriter(std::string path);
+  //! Удален конструктор копирования
+  CheckpointWriter(const CheckpointWriter &) = delete;
+  //! Удален конструктор переноса
+  CheckpointWriter(CheckpointWriter &&) noexcept = delete;
+  //! Удален оператор копирования
+  CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+  //! Удален оператор переноса
+  CheckpointWriter &operator=(CheckpointWriter &&) noexcept = delete;
+  //! Деструктор, дописывает ожидающую точку
+  ~CheckpointWriter();
+  /**
+   * @brief Поставить точку в очередь записи
+   * @details Бросает исключение предыдущей неудачной записи
+   * @param checkpoint Контрольная точка
+   */
+  void Submit(Checkpoint checkpoint);
+  //! Дождаться записи ожидающей точки
+  void Flush();
+  //! Получить путь до файла контрольной точки
+  const std::string &GetPath() const;
+  //! Получить количество записанных точек
+  std::size_t GetWritten() const;
+
+ private:
+  //! Цикл потока записи
+  void Run();
+  //! Бросить исключение неудачной записи, если оно было
+  void ThrowError();
+  //! Путь до файла контрольной точки
+  std::string path_;
+  //! Мьютекс очереди
+  mutable std::mutex mutex_;
+  //! Условная переменная очереди
+  std::condition_variable condition_;
+  //! Ожидающая точка
+  std::optional<Checkpoint> pending_;
+  //! Идет ли запись
+  bool writing_;
+  //! Флаг остановки потока
+  bool stop_;
+  //! Количество записанных точек
+  std::size_t written_;
+  //! Исключение неудачной записи
+  std::exception_ptr error_;
+  //! Поток записи
+  std::thread worker_;
+};
+
+}  // namespace s21
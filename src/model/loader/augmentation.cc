@@ -0,0 +1,191 @@
+#include "augmentation.h"
+
+#include <random>
+
+#include "random.h"
+
+namespace s21 {
+
+namespace {
+
+class Random {
+ public:
+  Random(const std::uint64_t seed, const std::uint64_t key)
+      : engine_(SplitMix(seed ^ SplitMix(key))) {}
+  float Uniform(const float limit) {
+    return limit * (2.f * UnitFloat(engine_()) - 1.f);
+  }
+
+ private:
+  std::mt19937_64 engine_;
+};
+
+}  // namespace
+
+Augmentation::Augmentation() : Augmentation(Options{}, 0) {}
+
+Augmentation::Augmentation(const Options &options, const std::uint64_t seed)
+    : options_(options), seed_(seed), kernel_() {
+  const float sigma = std::max(options_.elastic_sigma, 0.f);
+  const std::size_t radius =
+      sigma > 0.f
+          ? std::min(static_cast<std::size_t>(std::ceil(3.f * sigma)), side - 1)
+          : 0;
+  kernel_.resize(radius + 1);
+  float sum = 0.f;
+  for (std::size_t index = 0; index <= radius; ++index) {
+    const auto offset = static_cast<float>(index);
+    kernel_[index] =
+        sigma > 0.f ? std::exp(-offset * offset / (2.f * sigma * sigma)) : 1.f;
+    sum += index == 0 ? kernel_[index] : 2.f * kernel_[index];
+  }
+  for (auto &weight : kernel_) {
+    weight /= sum;
+  }
+}
+
+void Augmentation::Apply(const Matrix<float> &source, Matrix<float> &target,
+                         const std::uint64_t key) const {
+  if (source.Size() != side * side || target.Size() != side * side) {
+    throw std::invalid_argument("Bad augmentation: sensors must be 784x1");
+  }
+  Random random(seed_, key);
+  const float angle = random.Uniform(options_.rotation),
+              shear = random.Uniform(options_.shear),
+              shift_x = random.Uniform(options_.shift),
+              shift_y = random.Uniform(options_.shift),
+              thickness = random.Uniform(options_.thickness);
+  Cells dx{}, dy{};
+  if (options_.elastic_alpha > 0.f) {
+    for (std::size_t index = 0; index < dx.size(); ++index) {
+      dx[index] = random.Uniform(1.f);
+      dy[index] = random.Uniform(1.f);
+    }
+    Smooth(dx);
+    Smooth(dy);
+    float peak = 0.f;
+    for (std::size_t index = 0; index < dx.size(); ++index) {
+      peak = std::max({peak, std::fabs(dx[index]), std::fabs(dy[index])});
+    }
+    const float scale = peak > 0.f ? options_.elastic_alpha / peak : 0.f;
+    for (std::size_t index = 0; index < dx.size(); ++index) {
+      dx[index] *= scale;
+      dy[index] *= scale;
+    }
+  }
+  const float cos = std::cos(angle), sin = std::sin(angle);
+  const float a00 = cos, a01 = cos * shear - sin, a10 = sin,
+              a11 = sin * shear + cos;
+  const float center = static_cast<float>(side - 1) / 2.f;
+  Cells xs, ys;
+  for (std::size_t y = 0; y < side; ++y) {
+    const float yr = static_cast<float>(y) - center;
+    for (std::size_t x = 0; x < side; ++x) {
+      const float xr = static_cast<float>(x) - center;
+      const std::size_t index = y * side + x;
+      xs[index] = a00 * xr + a01 * yr + center + shift_x + dx[index];
+      ys[index] = a10 * xr + a11 * yr + center + shift_y + dy[index];
+    }
+  }
+  PaddedCells padded;
+  Pad(&source(0, 0), padded);
+  Cells cells;
+  const auto limit = static_cast<float>(side);
+  for (std::size_t index = 0; index < cells.size(); ++index) {
+    const float sx = std::clamp(xs[index], -1.f, limit),
+                sy = std::clamp(ys[index], -1.f, limit);
+    const float fx = std::floor(sx), fy = std::floor(sy);
+    const float wx = sx - fx, wy = sy - fy;
+    const auto base = static_cast<std::size_t>(
+        (static_cast<std::ptrdiff_t>(fy) + 2) * padded_side +
+        static_cast<std::ptrdiff_t>(fx) + 2);
+    const float top = padded[base] + wx * (padded[base + 1] - padded[base]);
+    const float bottom =
+        padded[base + padded_side] +
+        wx * (padded[base + padded_side + 1] - padded[base + padded_side]);
+    cells[index] = top + wy * (bottom - top);
+  }
+  if (thickness != 0.f) {
+    Thickness(cells, thickness);
+  }
+  std::copy(cells.begin(), cells.end(), &target(0, 0));
+}
+
+std::uint64_t Augmentation::Key(const std::size_t epoch,
+                                const std::size_t index) {
+  return SplitMix(static_cast<std::uint64_t>(epoch)) ^
+         static_cast<std::uint64_t>(index);
+}
+
+const Augmentation::Options &Augmentation::GetOptions() const {
+  return options_;
+}
+
+void Augmentation::Pad(const float *source, PaddedCells &padded) {
+  padded.fill(0.f);
+  for (std::size_t y = 0; y < side; ++y) {
+    std::copy_n(source + y * side, side, &padded[(y + 2) * padded_side + 2]);
+  }
+}
+
+void Augmentation::Smooth(Cells &field) const {
+  const auto radius = static_cast<std::ptrdiff_t>(kernel_.size() - 1);
+  const auto size = static_cast<std::ptrdiff_t>(side);
+  Cells buffer;
+  for (std::ptrdiff_t y = 0; y < size; ++y) {
+    const float *line = &field[y * size];
+    for (std::ptrdiff_t x = 0; x < size; ++x) {
+      float sum = kernel_[0] * line[x];
+      for (std::ptrdiff_t offset = 1; offset <= radius; ++offset) {
+        const float left = x - offset >= 0 ? line[x - offset] : 0.f;
+        const float right = x + offset < size ? line[x + offset] : 0.f;
+        sum += kernel_[offset] * (left + right);
+      }
+      buffer[y * size + x] = sum;
+    }
+  }
+  for (std::ptrdiff_t y = 0; y < size; ++y) {
+    float *line = &field[y * size];
+    for (std::ptrdiff_t x = 0; x < size; ++x) {
+      line[x] = kernel_[0] * buffer[y * size + x];
+    }
+    for (std::ptrdiff_t offset = 1; offset <= radius; ++offset) {
+      const float weight = kernel_[offset];
+      if (y - offset >= 0) {
+        const float *up = &buffer[(y - offset) * size];
+        for (std::ptrdiff_t x = 0; x < size; ++x) {
+          line[x] += weight * up[x];
+        }
+      }
+      if (y + offset < size) {
+        const float *down = &buffer[(y + offset) * size];
+        for (std::ptrdiff_t x = 0; x < size; ++x) {
+          line[x] += weight * down[x];
+        }
+      }
+    }
+  }
+}
+
+void Augmentation::Thickness(Cells &cells, const float amount) {
+  PaddedCells padded;
+  Pad(cells.data(), padded);
+  const float part = std::fabs(amount);
+  for (std::size_t y = 0; y < side; ++y) {
+    for (std::size_t x = 0; x < side; ++x) {
+      const std::size_t center = (y + 2) * padded_side + x + 2;
+      float extreme = padded[center];
+      for (const std::size_t row :
+           {center - padded_side, center, center + padded_side}) {
+        for (const std::size_t index : {row - 1, row, row + 1}) {
+          extreme = amount > 0.f ? std::max(extreme, padded[index])
+                                 : std::min(extreme, padded[index]);
+        }
+      }
+      float &cell = cells[y * side + x];
+      cell += part * (extreme - cell);
+    }
+  }
+}
+
+}  // namespace s21
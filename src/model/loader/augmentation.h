@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../../third-party/matrix.h"
+
+namespace s21 {
+
+//! Случайные искажения символов 28x28 для обучения
+class Augmentation {
+ public:
+  //! Сторона изображения EMNIST
+  static constexpr std::size_t side = 28;
+  //! Параметры искажений, ноль отключает искажение
+  struct Options {
+    float shift = 1.5f;          //!< Максимальный сдвиг в пикселях
+    float rotation = 0.15f;      //!< Максимальный поворот в радианах
+    float shear = 0.15f;         //!< Максимальный скос
+    float elastic_alpha = 1.5f;  //!< Амплитуда упругого искажения в пикселях
+    float elastic_sigma = 3.f;   //!< Сглаживание поля упругого искажения
+    float thickness = 0.5f;      //!< Максимальное изменение толщины штриха
+  };
+  //! Конструктор с дефолтными параметрами и нулевым зерном
+  Augmentation();
+  /**
+   * @brief Конструктор с заданными параметрами
+   * @param options Параметры искажений
+   * @param seed Зерно случайных искажений
+   */
+  Augmentation(const Options &options, std::uint64_t seed);
+  /**
+   * @brief Исказить изображение
+   * @details Искажение зависит только от зерна и ключа, поэтому не зависит
+   * от потока, в котором выполняется
+   * @param source Исходные сенсоры 784x1
+   * @param target Искаженные сенсоры 784x1
+   * @param key Ключ примера (например, эпоха и индекс примера)
+   */
+  void Apply(const Matrix<float> &source, Matrix<float> &target,
+             std::uint64_t key) const;
+  /**
+   * @brief Собрать ключ примера
+   * @param epoch Номер эпохи
+   * @param index Индекс примера в выборке
+   * @return Ключ примера
+   */
+  static std::uint64_t Key(std::size_t epoch, std::size_t index);
+  //! Получить параметры искажений
+  const Options &GetOptions() const;
+
+ private:
+  //! Сторона изображения с нулевой рамкой
+  static constexpr std::size_t padded_side = side + 4;
+  //! Изображение 28x28
+  typedef std::array<float, side * side> Cells;
+  //! Изображение с нулевой рамкой
+  typedef std::array<float, padded_side * padded_side> PaddedCells;
+  /**
+   * @brief Скопировать изображение внутрь нулевой рамки
+   * @param source Исходное изображение
+   * @param padded Изображение с рамкой
+   */
+  static void Pad(const float *source, PaddedCells &padded);
+  /**
+   * @brief Сгладить поле искажения гауссовым фильтром
+   * @param field Поле искажения
+   */
+  void Smooth(Cells &field) const;
+  /**
+   * @brief Изменить толщину штриха
+   * @param cells Изображение
+   * @param amount Доля расширения (>0) или сужения (<0)
+   */
+  static void Thickness(Cells &cells, float amount);
+  //! Параметры искажений
+  Options options_;
+  //! Зерно случайных искажений
+  std::uint64_t seed_;
+  //! Половина ядра сглаживания упругого поля, начиная с центра
+  std::vector<float> kernel_;
+};
+
+}  // namespace s21
@@ -0,0 +1,172 @@
+#include "data_loader.h"
+
+#include <numeric>
+#include <random>
+
+#include "random.h"
+
+namespace s21 {
+
+namespace {
+
+std::vector<std::size_t> AllIndices(const std::size_t size) {
+  std::vector<std::size_t> indices(size);
+  std::iota(indices.begin(), indices.end(), 0);
+  return indices;
+}
+
+}  // namespace
+
+DataLoader::DataLoader(const ReaderEMNIST &reader, const std::size_t batch_size,
+                       const std::uint64_t seed, const bool shuffle,
+                       const std::size_t count_workers)
+    : DataLoader(reader, AllIndices(reader.Size()), batch_size, seed, shuffle,
+                 count_workers) {}
+
+DataLoader::DataLoader(const ReaderEMNIST &reader,
+                       std::vector<std::size_t> indices,
+                       const std::size_t batch_size, const std::uint64_t seed,
+                       const bool shuffle, const std::size_t count_workers)
+    : reader_(reader),
+      indices_(std::move(indices)),
+      order_(),
+      batch_size_(std::max(batch_size, 1lu)),
+      seed_(seed),
+      shuffle_(shuffle),
+      augmentation_(nullptr),
+      epoch_(0),
+      slots_(std::max(count_workers, 1lu) + 1),
+      states_(slots_.size(), SlotState::Free),
+      produce_slot_(0),
+      consume_slot_(0),
+      position_(0),
+      filling_(0),
+      stop_(false),
+      mutex_(),
+      condition_(),
+      workers_() {
+  const std::size_t rows =
+      indices_.empty() ? 1 : reader_[indices_.front()].first.GetRows();
+  for (auto &slot : slots_) {
+    slot.sensors.assign(batch_size_, Matrix<float>(rows, 1));
+    slot.answers.assign(batch_size_, 0);
+  }
+  for (std::size_t index = 1; index < slots_.size(); ++index) {
+    workers_.emplace_back(&DataLoader::Run, this);
+  }
+}
+
+DataLoader::~DataLoader() {
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void DataLoader::SetAugmentation(const Augmentation *augmentation) {
+  std::unique_lock lock(mutex_);
+  condition_.wait(lock, [this] { return filling_ == 0; });
+  augmentation_ = augmentation;
+}
+
+void DataLoader::StartEpoch(const std::size_t epoch, const std::size_t skip) {
+  std::unique_lock lock(mutex_);
+  condition_.wait(lock, [this] { return filling_ == 0; });
+  if (shuffle_) {
+    const auto permutation = Permutation(indices_.size(), seed_, epoch);
+    order_.resize(indices_.size());
+    for (std::size_t index = 0; index < order_.size(); ++index) {
+      order_[index] = indices_[permutation[index]];
+    }
+  } else {
+    order_ = indices_;
+  }
+  epoch_ = epoch;
+  position_ = std::min(skip, order_.size());
+  std::fill(states_.begin(), states_.end(), SlotState::Free);
+  produce_slot_ = consume_slot_ = 0;
+  lock.unlock();
+  condition_.notify_all();
+}
+
+const DataLoader::Batch *DataLoader::Next() {
+  std::unique_lock lock(mutex_);
+  if (states_[consume_slot_] == SlotState::Held) {
+    states_[consume_slot_] = SlotState::Free;
+    consume_slot_ = (consume_slot_ + 1) % slots_.size();
+    condition_.notify_all();
+  }
+  condition_.wait(lock, [this] {
+    return states_[consume_slot_] == SlotState::Ready ||
+           (states_[consume_slot_] == SlotState::Free &&
+            position_ >= order_.size());
+  });
+  if (states_[consume_slot_] != SlotState::Ready) {
+    return nullptr;
+  }
+  states_[consume_slot_] = SlotState::Held;
+  return &slots_[consume_slot_];
+}
+
+std::size_t DataLoader::Size() const { return indices_.size(); }
+
+std::vector<std::size_t> DataLoader::Permutation(const std::size_t size,
+                                                 const std::uint64_t seed,
+                                                 const std::size_t epoch) {
+  std::vector<std::size_t> order = AllIndices(size);
+  std::mt19937_64 engine(SplitMix(seed ^ SplitMix(epoch)));
+  for (std::size_t index = size; index > 1; --index) {
+    std::swap(order[index - 1], order[engine() % index]);
+  }
+  return order;
+}
+
+void DataLoader::Run() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this] {
+      return stop_ || (position_ < order_.size() &&
+                       states_[produce_slot_] == SlotState::Free);
+    });
+    if (stop_) {
+      return;
+    }
+    const std::size_t slot = produce_slot_, begin = position_,
+                      end = std::min(begin + batch_size_, order_.size());
+    position_ = end;
+    states_[slot] = SlotState::Filling;
+    produce_slot_ = (slot + 1) % slots_.size();
+    ++filling_;
+    lock.unlock();
+    Fill(slots_[slot], begin, end);
+    lock.lock();
+    --filling_;
+    states_[slot] = SlotState::Ready;
+    condition_.notify_all();
+  }
+}
+
+void DataLoader::Fill(Batch &batch, const std::size_t begin,
+                      const std::size_t end) const {
+  batch.size = end - begin;
+  for (std::size_t index = begin; index < end; ++index) {
+    const auto &[sensors, answer] = reader_[order_[index]];
+    Matrix<float> &target = batch.sensors[index - begin];
+    if (augmentation_ != nullptr) {
+      augmentation_->Apply(sensors, target,
+                           Augmentation::Key(epoch_, order_[index]));
+    } else if (target.GetRows() == sensors.GetRows() &&
+               target.GetColumns() == sensors.GetColumns()) {
+      std::copy_n(&sensors(0, 0), sensors.Size(), &target(0, 0));
+    } else {
+      target = sensors;
+    }
+    batch.answers[index - begin] = answer;
+  }
+}
+
+}  // namespace s21
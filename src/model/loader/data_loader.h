@@ -0,0 +1,145 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../reader/reader_emnist.h"
+#include "augmentation.h"
+
+namespace s21 {
+
+/**
+ * @brief Загрузчик обучающей выборки с перемешиванием и предзагрузкой пачек
+ * @details Фоновые потоки заполняют кольцо буферов пачек (по буферу на поток
+ * и еще один выдается обучению), пачки выдаются строго по порядку эпохи
+ */
+class DataLoader {
+ public:
+  //! Пачка обучающих примеров
+  struct Batch {
+    std::vector<Matrix<float>> sensors;  //!< Входные сенсоры
+    std::vector<std::size_t> answers;    //!< Правильные индексы
+    std::size_t size = 0;                //!< Количество заполненных примеров
+  };
+  //! Удален дефолтный конструктор
+  DataLoader() = delete;
+  /**
+   * @brief Конструктор загрузчика всей выборки
+   * @param reader Ридер с выборкой, должен жить дольше загрузчика
+   * @param batch_size Размер пачки
+   * @param seed Зерно перемешивания
+   * @param shuffle Перемешивать ли выборку каждую эпоху
+   * @param count_workers Количество фоновых потоков
+   */
+  DataLoader(const ReaderEMNIST &reader, std::size_t batch_size,
+             std::uint64_t seed, bool shuffle = true,
+             std::size_t count_workers = 1);
+  /**
+   * @brief Конструктор загрузчика части выборки
+   * @param reader Ридер с выборкой, должен жить дольше загрузчика
+   * @param indices Индексы используемых примеров
+   * @param batch_size Размер пачки
+   * @param seed Зерно перемешивания
+   * @param shuffle Перемешивать ли выборку каждую эпоху
+   * @param count_workers Количество фоновых потоков
+   */
+  DataLoader(const ReaderEMNIST &reader, std::vector<std::size_t> indices,
+             std::size_t batch_size, std::uint64_t seed, bool shuffle = true,
+             std::size_t count_workers = 1);
+  //! Удален конструктор копирования
+  DataLoader(const DataLoader &) = delete;
+  //! Удален конструктор переноса
+  DataLoader(DataLoader &&) noexcept = delete;
+  //! Удален оператор копирования
+  DataLoader &operator=(const DataLoader &) = delete;
+  //! Удален оператор переноса
+  DataLoader &operator=(DataLoader &&) noexcept = delete;
+  //! Деструктор с остановкой фоновых потоков
+  ~DataLoader();
+  /**
+   * @brief Установить искажения примеров
+   * @details Применяются фоновыми потоками со следующей эпохи
+   * @param augmentation Указатель на искажения, nullptr - без искажений
+   */
+  void SetAugmentation(const Augmentation *augmentation);
+  /**
+   * @brief Начать эпоху
+   * @details Строит перестановку эпохи и запускает предзагрузку пачек
+   * @param epoch Номер эпохи
+   * @param skip Количество пропускаемых первых примеров эпохи
+   */
+  void StartEpoch(std::size_t epoch, std::size_t skip = 0);
+  /**
+   * @brief Получить следующую пачку текущей эпохи
+   * @details Предыдущая полученная пачка возвращается загрузчику
+   * @return Указатель на пачку или nullptr в конце эпохи
+   */
+  const Batch *Next();
+  //! Количество примеров в эпохе
+  std::size_t Size() const;
+  /**
+   * @brief Построить перестановку эпохи
+   * @details Перестановка зависит только от размера, зерна и номера эпохи
+   * @param size Количество примеров
+   * @param seed Зерно перемешивания
+   * @param epoch Номер эпохи
+   * @return Вектор перемешанных индексов от 0 до size
+   */
+  static std::vector<std::size_t> Permutation(std::size_t size,
+                                              std::uint64_t seed,
+                                              std::size_t epoch);
+
+ private:
+  //! Состояние буфера пачки
+  enum class SlotState { Free, Filling, Ready, Held };
+  //! Цикл фонового потока
+  void Run();
+  /**
+   * @brief Заполнить пачку примерами
+   * @param batch Пачка
+   * @param begin Позиция первого примера в порядке эпохи
+   * @param end Позиция за последним примером в порядке эпохи
+   */
+  void Fill(Batch &batch, std::size_t begin, std::size_t end) const;
+  //! Ридер с выборкой
+  const ReaderEMNIST &reader_;
+  //! Индексы используемых примеров
+  std::vector<std::size_t> indices_;
+  //! Порядок примеров текущей эпохи
+  std::vector<std::size_t> order_;
+  //! Размер пачки
+  std::size_t batch_size_;
+  //! Зерно перемешивания
+  std::uint64_t seed_;
+  //! Перемешивать ли выборку
+  bool shuffle_;
+  //! Искажения примеров
+  const Augmentation *augmentation_;
+  //! Номер текущей эпохи
+  std::size_t epoch_;
+  //! Буферы пачек
+  std::vector<Batch> slots_;
+  //! Состояния буферов пачек
+  std::vector<SlotState> states_;
+  //! Следующий заполняемый буфер
+  std::size_t produce_slot_;
+  //! Следующий выдаваемый буфер
+  std::size_t consume_slot_;
+  //! Позиция следующего загружаемого примера в порядке эпохи
+  std::size_t position_;
+  //! Количество заполняемых сейчас буферов
+  std::size_t filling_;
+  //! Остановить ли фоновые потоки
+  bool stop_;
+  //! Мьютекс состояния
+  std::mutex mutex_;
+  //! Условная переменная изменения состояния
+  std::condition_variable condition_;
+  //! Фоновые потоки
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace s21
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+namespace s21 {
+
+/**
+ * @brief Перемешать биты 64-битного значения (SplitMix64)
+ * @param value Исходное значение
+ * @return Перемешанное значение
+ */
+inline std::uint64_t SplitMix(std::uint64_t value) {
+  value += 0x9e3779b97f4a7c15ull;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+  return value ^ (value >> 31);
+}
+
+/**
+ * @brief Перевести случайное 64-битное значение в число из [0, 1)
+ * @param value Случайное значение
+ * @return Число из [0, 1)
+ */
+inline float UnitFloat(std::uint64_t value) {
+  return static_cast<float>(value >> 40) * 0x1.0p-24f;
+}
+
+}  // namespace s21
@@ -0,0 +1,192 @@
+#include "decimation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+namespace s21 {
+
+namespace {
+
+std::vector<PlotPoint> Copy(const std::vector<float> &values,
+                            const std::size_t begin, const std::size_t end) {
+  std::vector<PlotPoint> points;
+  points.reserve(end - begin);
+  for (std::size_t index = begin; index < end; ++index) {
+    points.push_back({static_cast<double>(index), values[index]});
+  }
+  return points;
+}
+
+// Largest-Triangle-Three-Buckets по точкам [begin, end), точка index
+// задается функциями key и value
+template <class Key, class Value>
+std::vector<PlotPoint> Lttb(const std::size_t begin, const std::size_t end,
+                            const std::size_t threshold, const Key &key,
+                            const Value &value) {
+  const std::size_t count = end - begin;
+  std::vector<PlotPoint> points;
+  if (threshold < 3 || count <= threshold) {
+    points.reserve(count);
+    for (std::size_t index = begin; index < end; ++index) {
+      points.push_back({key(index), value(index)});
+    }
+    return points;
+  }
+  points.reserve(threshold);
+  points.push_back({key(begin), value(begin)});
+  const double every =
+      static_cast<double>(count - 2) / static_cast<double>(threshold - 2);
+  auto bound = [&](const std::size_t bucket) {
+    return begin + 1 +
+           static_cast<std::size_t>(std::floor(static_cast<double>(bucket) *
+                                               every));
+  };
+  std::size_t selected = begin;
+  for (std::size_t bucket = 0; bucket + 2 < threshold; ++bucket) {
+    const std::size_t next_begin = bound(bucket + 1),
+                      next_end = std::min(bound(bucket + 2), end);
+    double average_key = 0., average_value = 0.;
+    for (std::size_t index = next_begin; index < next_end; ++index) {
+      average_key += key(index);
+      average_value += value(index);
+    }
+    const auto next_count =
+        static_cast<double>(std::max(next_end - next_begin, std::size_t{1}));
+    average_key /= next_count;
+    average_value /= next_count;
+    const double selected_key = key(selected),
+                 selected_value = value(selected);
+    double max_area = -1.;
+    for (std::size_t index = bound(bucket); index < next_begin; ++index) {
+      const double area =
+          std::abs((selected_key - average_key) *
+                       (value(index) - selected_value) -
+                   (selected_key - key(index)) *
+                       (average_value - selected_value));
+      if (area > max_area) {
+        max_area = area;
+        selected = index;
+      }
+    }
+    points.push_back({key(selected), value(selected)});
+  }
+  points.push_back({key(end - 1), value(end - 1)});
+  return points;
+}
+
+// Корзины сводки, пересекающие отрезок примеров [begin, end)
+std::pair<std::size_t, std::size_t> VisibleBuckets(const LossCurve &curve,
+                                                   const double begin,
+                                                   const double end) {
+  const auto &buckets = curve.GetBuckets();
+  auto first = std::upper_bound(
+      buckets.begin(), buckets.end(), begin,
+      [](const double key, const LossCurve::Bucket &bucket) {
+        return key < static_cast<double>(bucket.begin);
+      });
+  if (first != buckets.begin() &&
+      static_cast<double>(std::prev(first)->begin + std::prev(first)->count) >
+          begin) {
+    --first;
+  }
+  const auto last = std::lower_bound(
+      first, buckets.end(), end,
+      [](const LossCurve::Bucket &bucket, const double key) {
+        return static_cast<double>(bucket.begin) < key;
+      });
+  return {static_cast<std::size_t>(first - buckets.begin()),
+          static_cast<std::size_t>(last - buckets.begin())};
+}
+
+}  // namespace
+
+std::vector<PlotPoint> DecimateMinMax(const std::vector<float> &values,
+                                      std::size_t begin, std::size_t end,
+                                      const std::size_t buckets) {
+  end = std::min(end, values.size());
+  begin = std::min(begin, end);
+  const std::size_t count = end - begin;
+  if (buckets == 0 || count <= 2 * buckets) {
+    return Copy(values, begin, end);
+  }
+  std::vector<PlotPoint> points;
+  points.reserve(2 * buckets);
+  for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+    const auto first = values.begin() + static_cast<std::ptrdiff_t>(
+                                            begin + bucket * count / buckets),
+               last = values.begin() + static_cast<std::ptrdiff_t>(
+                                           begin +
+                                           (bucket + 1) * count / buckets);
+    auto [min, max] = std::minmax_element(first, last);
+    if (max < min) {
+      std::swap(min, max);
+    }
+    points.push_back({static_cast<double>(min - values.begin()), *min});
+    if (max != min) {
+      points.push_back({static_cast<double>(max - values.begin()), *max});
+    }
+  }
+  return points;
+}
+
+std::vector<PlotPoint> DecimateLttb(const std::vector<float> &values,
+                                    std::size_t begin, std::size_t end,
+                                    const std::size_t threshold) {
+  end = std::min(end, values.size());
+  begin = std::min(begin, end);
+  return Lttb(
+      begin, end, threshold,
+      [](const std::size_t index) { return static_cast<double>(index); },
+      [&values](const std::size_t index) {
+        return static_cast<double>(values[index]);
+      });
+}
+
+std::vector<PlotPoint> DecimateMinMax(const LossCurve &curve,
+                                      const double begin, const double end,
+                                      const std::size_t buckets) {
+  const auto &source = curve.GetBuckets();
+  const auto [first, last] = VisibleBuckets(curve, begin, end);
+  const std::size_t count = last - first,
+                    groups = buckets == 0 ? count : std::min(count, buckets);
+  std::vector<PlotPoint> points;
+  points.reserve(2 * groups);
+  for (std::size_t group = 0; group < groups; ++group) {
+    const auto *min = &source[first + group * count / groups];
+    const auto *max = min;
+    for (std::size_t index = first + group * count / groups + 1;
+         index < first + (group + 1) * count / groups; ++index) {
+      min = source[index].min < min->min ? &source[index] : min;
+      max = source[index].max > max->max ? &source[index] : max;
+    }
+    PlotPoint low{static_cast<double>(min->min_at), min->min},
+        high{static_cast<double>(max->max_at), max->max};
+    if (high.key < low.key) {
+      std::swap(low, high);
+    }
+    points.push_back(low);
+    if (high.key != low.key) {
+      points.push_back(high);
+    }
+  }
+  return points;
+}
+
+std::vector<PlotPoint> DecimateLttb(const LossCurve &curve,
+                                    const double begin, const double end,
+                                    const std::size_t threshold) {
+  const auto &source = curve.GetBuckets();
+  const auto [first, last] = VisibleBuckets(curve, begin, end);
+  return Lttb(
+      first, last, threshold,
+      [&source](const std::size_t index) {
+        const auto &bucket = source[index];
+        return static_cast<double>(bucket.begin) +
+               static_cast<double>(bucket.count - 1) / 2.;
+      },
+      [&source](const std::size_t index) { return source[index].Mean(); });
+}
+
+}  // namespace s21
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "loss_curve.h"
+
+namespace s21 {
+
+//! Точка графика
+struct PlotPoint {
+  double key;    //!< Номер примера
+  double value;  //!< Значение
+};
+
+/**
+ * @brief Прореживание по минимуму и максимуму
+ * @details Отрезок делится на buckets корзин, от каждой остаются минимум и
+ * максимум в исходном порядке. Выбросы не теряются ни при каком масштабе
+ * @param values Значения, ключ значения - его индекс
+ * @param begin Индекс первого значения отрезка
+ * @param end Индекс за последним значением отрезка
+ * @param buckets Количество корзин, обычно ширина графика в пикселях
+ * @return Не больше 2 * buckets точек
+ */
+std::vector<PlotPoint> DecimateMinMax(const std::vector<float> &values,
+                                      std::size_t begin, std::size_t end,
+                                      std::size_t buckets);
+
+/**
+ * @brief Прореживание Largest-Triangle-Three-Buckets
+ * @details Из каждой корзины выбирается точка, образующая наибольший
+ * треугольник с предыдущей выбранной точкой и средним следующей корзины.
+ * Форма линии сохраняется лучше, чем у минимума и максимума
+ * @param values Значения, ключ значения - его индекс
+ * @param begin Индекс первого значения отрезка
+ * @param end Индекс за последним значением отрезка
+ * @param threshold Количество точек результата, не меньше 3
+ * @return Не больше threshold точек
+ */
+std::vector<PlotPoint> DecimateLttb(const std::vector<float> &values,
+                                    std::size_t begin, std::size_t end,
+                                    std::size_t threshold);
+
+/**
+ * @brief Прореживание сводки ошибок по минимуму и максимуму
+ * @details Корзины сводки, пересекающие отрезок, объединяются в не больше
+ * buckets групп, от каждой остаются минимум и максимум на своих примерах.
+ * Работает за число видимых корзин и не требует исходных ошибок
+ * @param curve Сводка ошибок
+ * @param begin Номер первого видимого примера
+ * @param end Номер за последним видимым примером
+ * @param buckets Количество групп, обычно ширина графика в пикселях
+ * @return Не больше 2 * buckets точек
+ */
+std::vector<PlotPoint> DecimateMinMax(const LossCurve &curve, double begin,
+                                      double end, std::size_t buckets);
+
+/**
+ * @brief Прореживание сводки ошибок Largest-Triangle-Three-Buckets
+ * @details Точками служат средние корзин, пересекающих отрезок, с ключом в
+ * середине корзины
+ * @param curve Сводка ошибок
+ * @param begin Номер первого видимого примера
+ * @param end Номер за последним видимым примером
+ * @param threshold Количество точек результата, не меньше 3
+ * @return Не больше threshold точек
+ */
+std::vector<PlotPoint> DecimateLttb(const LossCurve &curve, double begin,
+                                    double end, std::size_t threshold);
+
+}  // namespace s21
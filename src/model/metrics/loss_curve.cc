@@ -0,0 +1,67 @@
+#include "loss_curve.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace s21 {
+
+LossCurve::LossCurve(const std::size_t max_buckets)
+    : max_buckets_(max_buckets), width_(1), count_(0), sum_(0.) {
+  if (max_buckets_ < 2 || max_buckets_ % 2 != 0) {
+    throw std::invalid_argument(
+        "Loss curve needs an even number of buckets, at least two.");
+  }
+  buckets_.reserve(max_buckets_);
+}
+
+void LossCurve::Add(const double value) {
+  if (buckets_.empty() || buckets_.back().count == width_) {
+    if (buckets_.size() == max_buckets_) {
+      Compact();
+    }
+    buckets_.push_back({count_, 0, 0., std::numeric_limits<double>::max(),
+                        std::numeric_limits<double>::lowest(), count_,
+                        count_});
+  }
+  auto &bucket = buckets_.back();
+  ++bucket.count;
+  bucket.sum += value;
+  if (value < bucket.min) {
+    bucket.min = value;
+    bucket.min_at = count_;
+  }
+  if (value > bucket.max) {
+    bucket.max = value;
+    bucket.max_at = count_;
+  }
+  ++count_;
+  sum_ += value;
+}
+
+const std::vector<LossCurve::Bucket> &LossCurve::GetBuckets() const {
+  return buckets_;
+}
+
+std::size_t LossCurve::GetBucketWidth() const { return width_; }
+
+std::size_t LossCurve::Size() const { return count_; }
+
+double LossCurve::Mean() const {
+  return count_ == 0 ? 0. : sum_ / static_cast<double>(count_);
+}
+
+void LossCurve::Compact() {
+  for (std::size_t index = 0; index < buckets_.size() / 2; ++index) {
+    const auto &left = buckets_[2 * index], &right = buckets_[2 * index + 1];
+    const auto &min = right.min < left.min ? right : left;
+    const auto &max = right.max > left.max ? right : left;
+    buckets_[index] = {left.begin, left.count + right.count,
+                       left.sum + right.sum, min.min, max.max, min.min_at,
+                       max.max_at};
+  }
+  buckets_.resize(buckets_.size() / 2);
+  width_ *= 2;
+}
+
+}  // namespace s21
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Потоковая сводка ошибок обучения ограниченного размера
+ * @details Ошибки копятся в корзинах одинаковой ширины. Когда корзины
+ * кончаются, соседние попарно сливаются, а ширина удваивается. Память не
+ * зависит от размера выборки, а каждая корзина хранит минимум, среднее и
+ * максимум своих примеров
+ */
+class LossCurve {
+ public:
+  //! Количество корзин по умолчанию
+  static constexpr std::size_t default_buckets = 512;
+  //! Корзина ошибок
+  struct Bucket {
+    std::size_t begin;  //!< Номер первого примера
+    std::size_t count;  //!< Количество примеров
+    double sum;         //!< Сумма ошибок
+    double min;         //!< Минимальная ошибка
+    double max;         //!< Максимальная ошибка
+    std::size_t min_at;  //!< Номер примера с минимальной ошибкой
+    std::size_t max_at;  //!< Номер примера с максимальной ошибкой
+    //! Средняя ошибка
+    double Mean() const {
+      return count == 0 ? 0. : sum / static_cast<double>(count);
+    }
+  };
+  /**
+   * @brief Конструктор
+   * @param max_buckets Максимальное количество корзин, четное и не меньше 2
+   */
+  explicit LossCurve(std::size_t max_buckets = default_buckets);
+  /**
+   * @brief Добавить ошибку очередного примера
+   * @param value Ошибка
+   */
+  void Add(double value);
+  //! Получить корзины по порядку примеров
+  const std::vector<Bucket> &GetBuckets() const;
+  //! Получить ширину корзины в примерах
+  std::size_t GetBucketWidth() const;
+  //! Получить количество добавленных ошибок
+  std::size_t Size() const;
+  //! Получить среднюю ошибку всех примеров
+  double Mean() const;
+
+ private:
+  //! Слить соседние корзины попарно
+  void Compact();
+  //! Максимальное количество корзин
+  std::size_t max_buckets_;
+  //! Ширина корзины
+  std::size_t width_;
+  //! Количество ошибок
+  std::size_t count_;
+  //! Сумма ошибок
+  double sum_;
+  //! Корзины
+  std::vector<Bucket> buckets_;
+};
+
+}  // namespace s21
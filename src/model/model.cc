@@ -1,34 +1,62 @@
 #include "model.h"
 
-#include <ctime>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <numeric>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <utility>
 
+#include "loader/random.h"
+
 namespace s21 {
 
 Model::Model()
-    : count_layers_(2),
-      count_neurons_(64),
+    : hidden_layers_{64, 64},
       type_network_(TypeNetwork::Matrix),
+      static_engine_(false),
       count_epoch_(1),
       k_valid_(1),
       learning_rate_(0.2f),
       test_sample_(1.f),
-      network_(new MatrixNetwork({inner_layer_size, count_neurons_,
-                                  count_neurons_, outer_layer_size})) {}
+      seed_(42),
+      weight_init_(WeightInit::Scheme::Uniform),
+      shuffle_(true),
+      epoch_(0),
+      end_epoch_(0),
+      resume_skip_(0),
+      resumed_(false),
+      augmentation_(false),
+      augmentation_options_(),
+      validation_options_(),
+      network_(std::make_unique<MatrixNetwork>(
+          GetTopology(), WeightInit{seed_, weight_init_})),
+      published_(),
+      snapshots_(),
+      next_snapshot_(0),
+      snapshot_period_(0),
+      session_(network_.get()),
+      checkpoint_period_(0),
+      checkpoint_writer_() {
+  Publish();
+}
 
-Model::~Model() { delete network_; }
+Model::~Model() = default;
 
 void Model::SetMatrixNetwork() {
   if (type_network_ == TypeNetwork::Matrix) {
     return;
   }
   type_network_ = TypeNetwork::Matrix;
-  UpdateNetwork();
+  ConvertNetwork();
 }
 
 bool Model::IsMatrixNetwork() const {
-  return type_network_ == TypeNetwork::Matrix;
+  return type_network_ == TypeNetwork::Matrix ||
+         (type_network_ == TypeNetwork::Static && !static_engine_);
 }
 
 void Model::SetGraphNetwork() {
@@ -36,13 +64,23 @@ void Model::SetGraphNetwork() {
     return;
   }
   type_network_ = TypeNetwork::Graph;
-  UpdateNetwork();
+  ConvertNetwork();
 }
 
 bool Model::IsGraphNetwork() const {
   return type_network_ == TypeNetwork::Graph;
 }
 
+void Model::SetStaticNetwork() {
+  if (type_network_ == TypeNetwork::Static) {
+    return;
+  }
+  type_network_ = TypeNetwork::Static;
+  ConvertNetwork();
+}
+
+bool Model::IsStaticNetwork() const { return static_engine_; }
+
 void Model::SetLearningRate(float learning_rate) {
   learning_rate = std::max(learning_rate, 0.f);
   learning_rate_ = learning_rate;
@@ -52,25 +90,55 @@ float Model::GetLearningRate() const { return learning_rate_; }
 
 void Model::SetCountLayers(std::size_t count_layers) {
   count_layers = std::max(count_layers, 1lu);
-  if (count_layers_ == count_layers) {
+  if (hidden_layers_.size() == count_layers) {
     return;
   }
-  count_layers_ = count_layers;
+  hidden_layers_.resize(count_layers, hidden_layers_.back());
   UpdateNetwork();
 }
 
-std::size_t Model::GetCountLayers() const { return count_layers_; }
+std::size_t Model::GetCountLayers() const { return hidden_layers_.size(); }
 
 void Model::SetCountNeurons(std::size_t count_neurons) {
   count_neurons = std::max(count_neurons, 1lu);
-  if (count_neurons_ == count_neurons) {
+  if (std::all_of(hidden_layers_.begin(), hidden_layers_.end(),
+                  [count_neurons](const std::size_t neurons) {
+                    return neurons == count_neurons;
+                  })) {
     return;
   }
-  count_neurons_ = count_neurons;
+  hidden_layers_.assign(hidden_layers_.size(), count_neurons);
   UpdateNetwork();
 }
 
-std::size_t Model::GetCountNeurons() const { return count_neurons_; }
+std::size_t Model::GetCountNeurons() const { return hidden_layers_.front(); }
+
+void Model::SetHiddenLayers(const std::vector<std::size_t> &hidden_layers) {
+  if (hidden_layers.empty()) {
+    throw std::invalid_argument(
+        "The network must have at least one hidden layer.");
+  }
+  if (std::find(hidden_layers.begin(), hidden_layers.end(), 0) !=
+      hidden_layers.end()) {
+    throw std::invalid_argument("The layer size can't be zero.");
+  }
+  if (hidden_layers_ == hidden_layers) {
+    return;
+  }
+  hidden_layers_ = hidden_layers;
+  UpdateNetwork();
+}
+
+const std::vector<std::size_t> &Model::GetHiddenLayers() const {
+  return hidden_layers_;
+}
+
+std::vector<std::size_t> Model::GetTopology() const {
+  std::vector<std::size_t> topology{inner_layer_size};
+  topology.insert(topology.end(), hidden_layers_.begin(), hidden_layers_.end());
+  topology.push_back(outer_layer_size);
+  return topology;
+}
 
 void Model::SetCountEpoch(const std::size_t count_epoch) {
   count_epoch_ = std::max(count_epoch, 1lu);
@@ -90,73 +158,503 @@ void Model::SetKValid(const std::size_t k_valid) {
 
 std::size_t Model::GetKValid() const { return k_valid_; }
 
+void Model::SetSeed(const std::uint64_t seed) {
+  seed_ = seed;
+  epoch_ = 0, resume_skip_ = 0, resumed_ = false;
+}
+
+std::uint64_t Model::GetSeed() const { return seed_; }
+
+void Model::SetWeightInit(const WeightInit::Scheme scheme) {
+  if (weight_init_ == scheme) {
+    return;
+  }
+  weight_init_ = scheme;
+  UpdateNetwork();
+}
+
+WeightInit::Scheme Model::GetWeightInit() const { return weight_init_; }
+
+void Model::ResetWeights() { UpdateNetwork(); }
+
+void Model::SetShuffle(const bool shuffle) { shuffle_ = shuffle; }
+
+bool Model::IsShuffle() const { return shuffle_; }
+
+void Model::SetAugmentation(const bool augmentation) {
+  augmentation_ = augmentation;
+}
+
+bool Model::IsAugmentation() const { return augmentation_; }
+
+void Model::SetAugmentationOptions(const Augmentation::Options &options) {
+  augmentation_options_ = options;
+}
+
+const Augmentation::Options &Model::GetAugmentationOptions() const {
+  return augmentation_options_;
+}
+
+void Model::SetValidationOptions(const ValidationOptions &options) {
+  validation_options_ = options;
+}
+
+const Model::ValidationOptions &Model::GetValidationOptions() const {
+  return validation_options_;
+}
+
+void Model::SetSnapshotPeriod(const std::size_t period) {
+  snapshot_period_ = period;
+}
+
+std::size_t Model::GetSnapshotPeriod() const { return snapshot_period_; }
+
 void Model::UpdateNetwork() {
-  std::vector<std::size_t> neurons;
-  neurons.push_back(inner_layer_size);
-  for (std::size_t index = 0; index < count_layers_; ++index) {
-    neurons.push_back(count_neurons_);
+  const auto neurons = GetTopology();
+  const WeightInit init{seed_, weight_init_};
+  std::unique_ptr<BaseNetwork> network;
+  bool is_static = false;
+  switch (type_network_) {
+    case TypeNetwork::Matrix:
+      network = std::make_unique<MatrixNetwork>(neurons, init);
+      break;
+    case TypeNetwork::Graph:
+      network = std::make_unique<GraphNetwork>(neurons, init);
+      break;
+    case TypeNetwork::Static:
+      network = MakeStaticMatrixNetwork(neurons, init);
+      is_static = network != nullptr;
+      if (!network) {
+        network = std::make_unique<MatrixNetwork>(neurons, init);
+      }
+      break;
+    default:
+      throw std::logic_error("Haven't network type");
   }
-  neurons.push_back(outer_layer_size);
-  delete network_;
+  network_ = std::move(network);
+  static_engine_ = is_static;
+  epoch_ = 0, resume_skip_ = 0, resumed_ = false;
+  session_.Reset(network_.get());
+  Publish();
+}
+
+void Model::ConvertNetwork() {
+  const auto layers = network_->GetLayerMatrices();
+  std::unique_ptr<BaseNetwork> network;
+  bool is_static = false;
   switch (type_network_) {
     case TypeNetwork::Matrix:
-      network_ = new MatrixNetwork(neurons);
+      network = std::make_unique<MatrixNetwork>(layers);
       break;
     case TypeNetwork::Graph:
-      network_ = new GraphNetwork(neurons);
+      network = std::make_unique<GraphNetwork>(layers);
+      break;
+    case TypeNetwork::Static:
+      network = MakeStaticMatrixNetwork(BaseNetwork::GetTopology(layers));
+      is_static = network != nullptr;
+      if (network) {
+        network->SetLayerMatrices(layers);
+      } else {
+        network = std::make_unique<MatrixNetwork>(layers);
+      }
       break;
     default:
       throw std::logic_error("Haven't network type");
   }
+  network_ = std::move(network);
+  static_engine_ = is_static;
+  session_.Reset(network_.get());
+  Publish();
+}
+
+void Model::Publish() {
+  auto &snapshot = snapshots_[next_snapshot_];
+  next_snapshot_ ^= 1;
+  // Флаг снимает удалитель последнего владельца версии с release, поэтому
+  // после чтения с acquire все чтения читателей завершены до перезаписи
+  if (!snapshot || snapshot->held.load(std::memory_order_acquire) ||
+      !snapshot->network->CopyWeightsFrom(*network_)) {
+    snapshot = std::make_shared<Snapshot>();
+    snapshot->network = network_->Clone();
+  }
+  snapshot->held.store(true, std::memory_order_relaxed);
+  published_.Publish(std::shared_ptr<const BaseNetwork>(
+      snapshot->network.get(), [snapshot](const BaseNetwork *) {
+        snapshot->held.store(false, std::memory_order_release);
+      }));
+}
+
+const Published<BaseNetwork> &Model::GetPublishedNetwork() const {
+  return published_;
 }
 
 void Model::SaveWeights(std::string path) const {
   network_->SaveWeights(std::move(path));
 }
 
+void Model::SaveBinaryWeights(const std::string &path) const {
+  network_->SaveBinaryWeights(path);
+}
+
 void Model::LoadWeights(std::string path) {
-  auto [count_layers, count_neurons] = network_->LoadWeights(std::move(path));
-  count_layers_ = count_layers, count_neurons_ = count_neurons;
+  if (type_network_ == TypeNetwork::Static) {
+    LoadStaticWeights(std::move(path));
+    return;
+  }
+  const auto topology = network_->LoadWeights(std::move(path));
+  hidden_layers_.assign(topology.begin() + 1, topology.end() - 1);
+  epoch_ = 0, resume_skip_ = 0, resumed_ = false;
+  session_.Reset(network_.get());
+  Publish();
+}
+
+void Model::SetCheckpoint(std::string path, const std::size_t period) {
+  checkpoint_writer_.reset();
+  checkpoint_period_ = period;
+  if (!path.empty()) {
+    checkpoint_writer_ = std::make_unique<CheckpointWriter>(std::move(path));
+  }
+}
+
+void Model::Resume(std::string path) {
+  auto checkpoint = Checkpoint::Load(path);
+  if (checkpoint.network > static_cast<std::uint8_t>(TypeNetwork::Static)) {
+    throw std::invalid_argument("Bad checkpoint: unknown network type.");
+  }
+  const auto topology = BaseNetwork::GetTopology(checkpoint.layers);
+  if (topology.front() != inner_layer_size ||
+      topology.back() != outer_layer_size) {
+    throw std::invalid_argument(
+        "Bad checkpoint: the network must have " +
+        std::to_string(inner_layer_size) + " inputs and " +
+        std::to_string(outer_layer_size) + " outputs.");
+  }
+  type_network_ = static_cast<TypeNetwork>(checkpoint.network);
+  hidden_layers_.assign(topology.begin() + 1, topology.end() - 1);
+  UpdateNetwork();
+  network_->SetLayerMatrices(checkpoint.layers);
+  session_.Reset(network_.get());
+  Publish();
+  learning_rate_ = checkpoint.learning_rate;
+  seed_ = checkpoint.seed;
+  shuffle_ = checkpoint.shuffle;
+  augmentation_ = checkpoint.augmentation;
+  augmentation_options_ = checkpoint.augmentation_options;
+  epoch_ = checkpoint.epoch;
+  resume_skip_ = checkpoint.skip;
+  end_epoch_ = checkpoint.end_epoch;
+  resumed_ = true;
+}
+
+void Model::SaveCheckpoint(const std::size_t epoch, const std::size_t skip) {
+  Checkpoint checkpoint;
+  checkpoint.network = static_cast<std::uint8_t>(type_network_);
+  checkpoint.learning_rate = learning_rate_;
+  checkpoint.seed = seed_;
+  checkpoint.shuffle = shuffle_;
+  checkpoint.augmentation = augmentation_;
+  checkpoint.augmentation_options = augmentation_options_;
+  checkpoint.epoch = epoch;
+  checkpoint.skip = skip;
+  checkpoint.end_epoch = std::max(end_epoch_, epoch);
+  checkpoint.layers = network_->GetLayerMatrices();
+  checkpoint_writer_->Submit(std::move(checkpoint));
+}
+
+void Model::LoadStaticWeights(std::string path) {
+  auto loaded = std::make_unique<MatrixNetwork>(
+      std::vector<std::size_t>{inner_layer_size, 1, 1, outer_layer_size});
+  const auto topology = loaded->LoadWeights(std::move(path));
+  std::unique_ptr<BaseNetwork> network = MakeStaticMatrixNetwork(topology);
+  const bool is_static = network != nullptr;
+  if (network) {
+    network->SetLayerMatrices(loaded->GetLayerMatrices());
+  } else {
+    network = std::move(loaded);
+  }
+  network_ = std::move(network);
+  static_engine_ = is_static;
+  hidden_layers_.assign(topology.begin() + 1, topology.end() - 1);
+  epoch_ = 0, resume_skip_ = 0, resumed_ = false;
+  session_.Reset(network_.get());
+  Publish();
 }
 
 Matrix<float> Model::ForwardFeed(const Matrix<float> &data) {
   return network_->ForwardFeed(data);
 }
 
-std::vector<double> Model::Learn(const ReaderEMNIST &reader) {
-  std::vector<double> mse;
-  auto learn_row =
-      [this, &mse](const std::vector<ReaderEMNIST::EmnistValue> &requests) {
-        for (auto &request : requests) {
-          network_->Learn(request.first, request.second, learning_rate_);
-          mse.push_back(network_->GetLastMse());
-        }
-      };
-  std::size_t delta = reader.Size() / k_valid_;
-  if (k_valid_ <= 2 || delta == 0) {
-    learn_row(reader.GetVector());
-  } else {
-    for (std::size_t index = 0; index < k_valid_; ++index) {
-      learn_row(reader.GetVector(0, index * delta));
-      learn_row(reader.GetVector((index + 1) * delta));
+Matrix<float> Model::ForwardFeedIncremental(const Matrix<float> &data) {
+  return session_.ForwardFeed(data);
+}
+
+LossCurve Model::Learn(const ReaderEMNIST &reader) {
+  return Learn(reader, nullptr);
+}
+
+LossCurve Model::Learn(const ReaderEMNIST &reader,
+                       const std::function<bool(double)> &step) {
+  session_.Reset(network_.get());
+  LossCurve mse;
+  const Augmentation augmentation(augmentation_options_, seed_);
+  const std::size_t count_workers =
+      augmentation_ ? std::max(std::thread::hardware_concurrency(), 2u) - 1
+                    : 1;
+  std::vector<std::size_t> indices(reader.Size());
+  std::iota(indices.begin(), indices.end(), 0);
+  DataLoader loader(reader, std::move(indices), loader_batch_size, seed_,
+                    shuffle_, count_workers);
+  if (augmentation_) {
+    loader.SetAugmentation(&augmentation);
+  }
+  const std::size_t epoch = epoch_++;
+  std::size_t position = std::exchange(resume_skip_, 0);
+  resumed_ = false;
+  S21_TRACE_SCOPE("Model::Learn epoch");
+  S21_PROFILE_SCOPE(Train);
+  loader.StartEpoch(epoch, position);
+  while (const auto *batch = loader.Next()) {
+    S21_TRACE_SCOPE("Model::Learn batch");
+    for (std::size_t index = 0; index < batch->size; ++index) {
+      network_->Learn(batch->sensors[index], batch->answers[index],
+                      learning_rate_);
+      S21_PROFILE_SAMPLES(1);
+      const double last_mse = network_->GetLastMse();
+      mse.Add(last_mse);
+      ++position;
+      if (snapshot_period_ != 0 && position % snapshot_period_ == 0) {
+        Publish();
+      }
+      if (checkpoint_writer_ && checkpoint_period_ != 0 &&
+          position % checkpoint_period_ == 0 && position < reader.Size()) {
+        SaveCheckpoint(epoch, position);
+      }
+      if (step && !step(last_mse)) {
+        Publish();
+        return mse;
+      }
     }
   }
+  if (checkpoint_writer_) {
+    SaveCheckpoint(epoch_, 0);
+  }
+  Publish();
   return mse;
 }
 
+std::vector<LossCurve> Model::Train(
+    const ReaderEMNIST &reader, const std::function<bool(double)> &step) {
+  if (!resumed_) {
+    end_epoch_ = epoch_ + count_epoch_;
+  }
+  bool stopped = false;
+  const std::function<bool(double)> observe = [&](const double mse) {
+    stopped = step && !step(mse);
+    return !stopped;
+  };
+  std::vector<LossCurve> mse;
+  while (!stopped && epoch_ < end_epoch_) {
+    mse.push_back(Learn(reader, observe));
+  }
+  resumed_ = false;
+  if (checkpoint_writer_) {
+    checkpoint_writer_->Flush();
+  }
+  return mse;
+}
+
+Model::FitOutput Model::Fit(const ReaderEMNIST &train,
+                            const ReaderEMNIST &validation,
+                            const std::function<bool(double)> &step) {
+  end_epoch_ = epoch_ + count_epoch_;
+  FitOutput output{{}, {}, {}, 0, false};
+  std::unique_ptr<BaseNetwork> best, pending;
+  std::future<double> pending_mse;
+  std::size_t without_improvement = 0, steps = 0, pending_steps = 0;
+  auto collect = [&] {
+    if (!pending_mse.valid()) {
+      return;
+    }
+    const double mse = pending_mse.get();
+    if (output.validation_mse.empty() ||
+        mse < output.validation_mse[output.best] -
+                  validation_options_.min_delta) {
+      output.best = output.validation_mse.size();
+      best = std::move(pending);
+      without_improvement = 0;
+    } else {
+      ++without_improvement;
+    }
+    pending.reset();
+    output.validation_mse.push_back(mse);
+    output.validation_steps.push_back(pending_steps);
+    output.stopped = validation_options_.patience != 0 &&
+                     without_improvement >= validation_options_.patience;
+  };
+  auto validate = [&] {
+    collect();
+    if (output.stopped) {
+      return false;
+    }
+    pending = network_->Clone();
+    pending_steps = steps;
+    pending_mse = std::async(std::launch::async, ValidationMse,
+                             std::ref(*pending), std::cref(validation));
+    return true;
+  };
+  bool interrupted = false;
+  auto observe = [&](const double mse) {
+    if (step && !step(mse)) {
+      interrupted = true;
+      return false;
+    }
+    ++steps;
+    return validation_options_.period == 0 ||
+           steps % validation_options_.period != 0 || validate();
+  };
+  for (std::size_t epoch = 0;
+       epoch < count_epoch_ && !output.stopped && !interrupted; ++epoch) {
+    output.mse.push_back(Learn(train, observe));
+    if (!output.stopped && !interrupted && validation_options_.period == 0) {
+      validate();
+    }
+  }
+  collect();
+  output.stopped = output.stopped || interrupted;
+  if (best) {
+    network_ = std::move(best);
+    session_.Reset(network_.get());
+    Publish();
+  }
+  return output;
+}
+
+Profiler::Stats Model::GetProfile() { return Profiler::GetStats(); }
+
+void Model::ResetProfile() { Profiler::Reset(); }
+
+void Model::StartTrace() { Tracer::Start(); }
+
+void Model::SaveTrace(const std::string &path) {
+  Tracer::Stop();
+  if (!path.empty()) {
+    Tracer::Write(path);
+  }
+}
+
 Model::TestOutput Model::Test(const ReaderEMNIST &reader) {
-  if (static_cast<std::size_t>(static_cast<float>(reader.Size()) *
-                               test_sample_) == 0lu) {
+  S21_TRACE_SCOPE("Model::Test");
+  const auto max_index = static_cast<std::size_t>(
+      static_cast<float>(reader.Size()) * test_sample_);
+  if (max_index == 0lu) {
     return TestOutput{};
   }
+  return Evaluate(*network_, reader, 0, max_index);
+}
+
+Model::CrossValidationOutput Model::CrossValidation(
+    const ReaderEMNIST &reader) const {
+  const std::size_t delta = reader.Size() / std::max(k_valid_, 1lu);
+  if (k_valid_ < 2 || delta == 0) {
+    throw std::invalid_argument(
+        "Cross-validation needs at least two non-empty folds.");
+  }
+  const auto start = std::chrono::steady_clock::now();
+  CrossValidationOutput output{std::vector<TestOutput>(k_valid_), {}, {}, 0};
+  std::vector<std::exception_ptr> errors(k_valid_);
+  const Augmentation augmentation(augmentation_options_, seed_);
+  auto run_fold = [&](const std::size_t fold) {
+    try {
+      const std::size_t begin = fold * delta,
+                        end = fold + 1 == k_valid_ ? reader.Size()
+                                                   : begin + delta;
+      std::vector<std::size_t> indices(reader.Size() - (end - begin));
+      std::iota(indices.begin(), indices.begin() + begin, 0);
+      std::iota(indices.begin() + begin, indices.end(), end);
+      auto network = network_->Clone();
+      DataLoader loader(reader, std::move(indices), loader_batch_size,
+                        SplitMix(seed_ + fold), shuffle_);
+      if (augmentation_) {
+        loader.SetAugmentation(&augmentation);
+      }
+      for (std::size_t epoch = 0; epoch < count_epoch_; ++epoch) {
+        loader.StartEpoch(epoch);
+        while (const auto *batch = loader.Next()) {
+          for (std::size_t index = 0; index < batch->size; ++index) {
+            network->Learn(batch->sensors[index], batch->answers[index],
+                           learning_rate_);
+          }
+        }
+      }
+      output.folds[fold] = Evaluate(*network, reader, begin, end);
+    } catch (...) {
+      errors[fold] = std::current_exception();
+    }
+  };
+  std::atomic<std::size_t> next{0};
+  auto worker = [&] {
+    for (std::size_t fold = next++; fold < k_valid_; fold = next++) {
+      run_fold(fold);
+    }
+  };
+  const std::size_t count_threads = std::min<std::size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u), k_valid_);
+  std::vector<std::thread> threads;
+  threads.reserve(count_threads);
+  for (std::size_t index = 0; index < count_threads; ++index) {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (const auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  for (auto metric : {&TestOutput::average_accuracy, &TestOutput::precision,
+                      &TestOutput::recall, &TestOutput::f_measure,
+                      &TestOutput::time_sec}) {
+    double sum = 0, sum_squares = 0;
+    for (const auto &fold : output.folds) {
+      sum += fold.*metric;
+      sum_squares += fold.*metric * fold.*metric;
+    }
+    const auto count = static_cast<double>(k_valid_);
+    output.mean.*metric = sum / count;
+    output.variance.*metric =
+        std::max(sum_squares / count - output.mean.*metric * output.mean.*metric,
+                 0.);
+  }
+  output.time_sec = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+  return output;
+}
+
+double Model::ValidationMse(BaseNetwork &network, const ReaderEMNIST &reader) {
+  double mse = 0;
+  for (std::size_t index = 0; index < reader.Size(); ++index) {
+    const auto &request = reader[index];
+    auto response = network.ForwardFeed(request.first);
+    for (std::size_t row = 0; row < response.GetRows(); ++row) {
+      const double error =
+          (row == request.second ? 1. : 0.) - response(row, 0);
+      mse += error * error;
+    }
+  }
+  return reader.Size() == 0 ? 0. : mse / static_cast<double>(reader.Size());
+}
+
+Model::TestOutput Model::Evaluate(BaseNetwork &network,
+                                  const ReaderEMNIST &reader,
+                                  const std::size_t begin,
+                                  const std::size_t end) {
   double TP = 0, FP = 0, FN = 0, TN = 0;
-  clock_t start = clock();
-  auto vector_requests = reader.GetVector();
-  const auto max_index = static_cast<std::size_t>(
-      static_cast<float>(vector_requests.size()) * test_sample_);
-  for (std::size_t index = 0; index < max_index; ++index) {
-    auto &request = vector_requests[index];
-    auto response = network_->ForwardFeed(request.first);
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t index = begin; index < end; ++index) {
+    const auto &request = reader[index];
+    auto response = network.ForwardFeed(request.first);
     for (std::size_t row = 0; row < response.GetRows(); ++row) {
       if (response(row, 0) >= 0.5f) {
         row == request.second ? ++TP : ++FP;
@@ -165,8 +663,9 @@ Model::TestOutput Model::Test(const ReaderEMNIST &reader) {
       }
     }
   }
-  const double time = static_cast<double>(clock() - start) /
-                      static_cast<double>(CLOCKS_PER_SEC),
+  const double time = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - start)
+                          .count(),
                average_accuracy = (TP + TN) / (TP + FP + FN + TN),
                precision = TP / (TP + FP), recall = TP / (TP + FN),
                f_measure = (2.f * precision * recall) / (precision + recall);
@@ -1,9 +1,21 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <functional>
+
+#include "checkpoint/checkpoint.h"
+#include "loader/data_loader.h"
+#include "metrics/loss_curve.h"
 #include "networks/base/base_network.h"
 #include "networks/graph/graph_network.h"
 #include "networks/matrix/matrix_network.h"
+#include "networks/static/static_matrix_network.h"
+#include "profiler/profiler.h"
+#include "profiler/tracer.h"
 #include "reader/reader_emnist.h"
+#include "session/inference_session.h"
+#include "session/network_replica.h"
 
 namespace s21 {
 
@@ -14,10 +26,43 @@ class Model {
   static constexpr std::size_t inner_layer_size = 784;
   //! Размер вы1ходного слоя
   static constexpr std::size_t outer_layer_size = 26;
+  //! Размер пачки загрузчика обучающей выборки
+  static constexpr std::size_t loader_batch_size = 64;
   //! Структура вывода теста
   struct TestOutput {
     double average_accuracy, precision, recall, f_measure, time_sec;
   };
+  //! Структура вывода кросс-валидации
+  struct CrossValidationOutput {
+    //! Метрики каждого блока на его отложенной части
+    std::vector<TestOutput> folds;
+    //! Среднее и дисперсия метрик по блокам
+    TestOutput mean, variance;
+    //! Общее время кросс-валидации
+    double time_sec;
+  };
+  //! Параметры валидации во время обучения
+  struct ValidationOptions {
+    //! Период валидации в обучающих примерах, 0 - в конце каждой эпохи
+    std::size_t period = 0;
+    //! Число валидаций без улучшения до остановки, 0 - без остановки
+    std::size_t patience = 0;
+    //! Минимальное уменьшение ошибки, которое считается улучшением
+    double min_delta = 0.;
+  };
+  //! Структура вывода обучения с валидацией
+  struct FitOutput {
+    //! Сводки ошибок обучающих примеров по эпохам
+    std::vector<LossCurve> mse;
+    //! Средняя ошибка на валидационной выборке в каждой точке валидации
+    std::vector<double> validation_mse;
+    //! Число обучающих примеров с начала обучения в каждой точке валидации
+    std::vector<std::size_t> validation_steps;
+    //! Индекс лучшей точки валидации, веса которой оставлены в модели
+    std::size_t best;
+    //! Остановлено ли обучение досрочно
+    bool stopped;
+  };
   //! Дефолтный конструктор
   Model();
   //! Удален конструктор копирования
@@ -35,10 +80,18 @@ class Model {
    */
   void SaveWeights(std::string) const;
   /**
-   * @brief Загрузить веса из файла в модель
+   * @brief Сохранить веса модели в бинарный файл
+   */
+  void SaveBinaryWeights(const std::string &) const;
+  /**
+   * @brief Загрузить веса из текстового или бинарного файла в модель
    */
   void LoadWeights(std::string);
-  //! Установить матричную сеть
+  /**
+   * @brief Установить матричную сеть
+   * @details Здесь и при смене на другие типы веса и смещения текущего
+   * перцептрона переносятся в новый без изменений
+   */
   void SetMatrixNetwork();
   //! Узнать матричная ли сеть
   bool IsMatrixNetwork() const;
@@ -46,18 +99,44 @@ class Model {
   void SetGraphNetwork();
   //! Узнать графовая ли сеть
   bool IsGraphNetwork() const;
+  /**
+   * @brief Установить статическую матричную сеть
+   * @details Для поставляемых топологий используется StaticMatrixNetwork с
+   * размерами слоев, известными при компиляции, для остальных - MatrixNetwork.
+   * Выбор сохраняется: при смене топологии на поставляемую снова включается
+   * статическая сеть
+   */
+  void SetStaticNetwork();
+  /**
+   * @brief Узнать статическая ли сеть
+   * @details Сообщает о сети, которая работает на самом деле: если топология
+   * не поставляется статической, вернет false, а IsMatrixNetwork - true
+   */
+  bool IsStaticNetwork() const;
   //! Установить скорость обучения
   void SetLearningRate(float);
   //! Получить скорость обучения
   float GetLearningRate() const;
-  //! Установить количество слоев
+  /**
+   * @brief Установить количество скрытых слоев
+   * @details Новые слои получают размер последнего скрытого слоя
+   */
   void SetCountLayers(std::size_t);
-  //! Получить количество слоев
+  //! Получить количество скрытых слоев
   std::size_t GetCountLayers() const;
-  //! Установить количество нейронов в слою
+  //! Установить одинаковое количество нейронов во всех скрытых слоях
   void SetCountNeurons(std::size_t);
-  //! Получить количество нейронов в слою
+  //! Получить количество нейронов в первом скрытом слое
   std::size_t GetCountNeurons() const;
+  /**
+   * @brief Установить размеры скрытых слоев
+   * @param hidden_layers Количество нейронов в каждом скрытом слое
+   */
+  void SetHiddenLayers(const std::vector<std::size_t> &hidden_layers);
+  //! Получить размеры скрытых слоев
+  const std::vector<std::size_t> &GetHiddenLayers() const;
+  //! Получить размеры всех слоев от входного до выходного
+  std::vector<std::size_t> GetTopology() const;
   //! Установить количество эпох обучения
   void SetCountEpoch(std::size_t);
   //! Получить количество эпох обучения
@@ -70,33 +149,202 @@ class Model {
   void SetKValid(std::size_t);
   //! Получить количество количество к-валидации
   std::size_t GetKValid() const;
+  /**
+   * @brief Установить зерно перемешивания и начальных весов
+   * @details Веса текущего перцептрона не меняются, зерно действует на
+   * следующий созданный перцептрон и ResetWeights
+   */
+  void SetSeed(std::uint64_t);
+  //! Получить зерно перемешивания и начальных весов
+  std::uint64_t GetSeed() const;
+  //! Установить схему начальной инициализации весов и пересоздать сеть
+  void SetWeightInit(WeightInit::Scheme);
+  //! Получить схему начальной инициализации весов
+  WeightInit::Scheme GetWeightInit() const;
+  //! Пересоздать сеть с начальными весами по текущим зерну и схеме
+  void ResetWeights();
+  //! Установить перемешивание обучающей выборки каждую эпоху
+  void SetShuffle(bool);
+  //! Узнать перемешивается ли обучающая выборка
+  bool IsShuffle() const;
+  //! Установить искажение обучающих примеров
+  void SetAugmentation(bool);
+  //! Узнать искажаются ли обучающие примеры
+  bool IsAugmentation() const;
+  //! Установить параметры искажения обучающих примеров
+  void SetAugmentationOptions(const Augmentation::Options &);
+  //! Получить параметры искажения обучающих примеров
+  const Augmentation::Options &GetAugmentationOptions() const;
+  //! Установить параметры валидации во время обучения
+  void SetValidationOptions(const ValidationOptions &);
+  //! Получить параметры валидации во время обучения
+  const ValidationOptions &GetValidationOptions() const;
+  /**
+   * @brief Установить период публикации весов во время обучения
+   * @details Распознавание из других потоков видит веса не старше периода
+   * @param period Период в обучающих примерах, 0 - только в конце эпохи
+   */
+  void SetSnapshotPeriod(std::size_t period);
+  //! Получить период публикации весов во время обучения
+  std::size_t GetSnapshotPeriod() const;
+  /**
+   * @brief Включить контрольные точки обучения
+   * @details Снимок состояния делается в памяти, а пишется в файл фоновым
+   * потоком. Пустой путь выключает контрольные точки
+   * @param path Путь до файла контрольной точки
+   * @param period Период в обучающих примерах, 0 - только в конце эпохи
+   */
+  void SetCheckpoint(std::string path, std::size_t period = 0);
+  /**
+   * @brief Восстановить модель из контрольной точки
+   * @details Следующий вызов Train продолжит прерванное обучение с той же
+   * позиции и даст те же веса, что и непрерывное обучение. Если точка
+   * повреждена или не подходит к входам и выходам модели, бросает
+   * исключение и не меняет модель
+   * @param path Путь до файла контрольной точки
+   */
+  void Resume(std::string path);
   /**
    * @brief Обработать входные сенсоры
    * @param sensors Входные сенсоры
    */
   Matrix<float> ForwardFeed(const Matrix<float> &sensors);
+  /**
+   * @brief Обработать входные сенсоры инкрементально
+   * @details Первый слой пересчитывается только по сенсорам, изменившимся с
+   * прошлого вызова. Подходит для распознавания во время рисования
+   * @param sensors Входные сенсоры
+   */
+  Matrix<float> ForwardFeedIncremental(const Matrix<float> &sensors);
   /**
    * @brief Обучить перцептрон
    * @param reader Ридер с обучающей выборкой
+   * @return Сводка ошибок обучающих примеров
    */
-  std::vector<double> Learn(const ReaderEMNIST &reader);
+  LossCurve Learn(const ReaderEMNIST &reader);
+  /**
+   * @brief Обучить перцептрон одну эпоху с наблюдением за шагами
+   * @param reader Ридер с обучающей выборкой
+   * @param step Вызывается с ошибкой после каждого примера, false прерывает
+   * эпоху
+   * @return Сводка ошибок обучающих примеров
+   */
+  LossCurve Learn(const ReaderEMNIST &reader,
+                  const std::function<bool(double)> &step);
+  /**
+   * @brief Обучить перцептрон count_epoch эпох
+   * @details После Resume доучивает прерванное обучение. Перед возвратом
+   * дожидается записи последней контрольной точки
+   * @param reader Ридер с обучающей выборкой
+   * @param step Вызывается с ошибкой после каждого примера, false прерывает
+   * обучение
+   * @return Сводки ошибок обучающих примеров по эпохам
+   */
+  std::vector<LossCurve> Train(
+      const ReaderEMNIST &reader,
+      const std::function<bool(double)> &step = nullptr);
+  /**
+   * @brief Обучить перцептрон с периодической валидацией
+   * @details Обучение идет count_epoch эпох. В каждой точке валидации снимок
+   * весов проверяется в фоновом потоке, пока обучение продолжается. Если
+   * ошибка не улучшается patience валидаций подряд, обучение прерывается. В
+   * модели остаются веса лучшей точки валидации
+   * @param train Ридер с обучающей выборкой
+   * @param validation Ридер с валидационной выборкой
+   * @param step Вызывается с ошибкой после каждого примера, false прерывает
+   * обучение
+   */
+  FitOutput Fit(const ReaderEMNIST &train, const ReaderEMNIST &validation,
+                const std::function<bool(double)> &step = nullptr);
   /**
    * @brief Протестировать перцептрон
    * @param reader Ридер с тестовой выборкой
    */
   TestOutput Test(const ReaderEMNIST &reader);
+  /**
+   * @brief Провести k-блочную кросс-валидацию
+   * @details Выборка делится на k_valid блоков. Для каждого блока копия
+   * перцептрона обучается count_epoch эпох на остальных блоках и тестируется
+   * на отложенном. Блоки разбирают не больше hardware_concurrency потоков.
+   * Веса модели не меняются
+   * @param reader Ридер с обучающей выборкой
+   */
+  CrossValidationOutput CrossValidation(const ReaderEMNIST &reader) const;
+  /**
+   * @brief Получить накопленные таймеры фаз и счетчики памяти
+   * @details Без опции сборки S21_PROFILE таймеры и счетчик примеров
+   * остаются нулевыми, счетчики памяти матриц работают всегда
+   */
+  static Profiler::Stats GetProfile();
+  //! Обнулить таймеры фаз
+  static void ResetProfile();
+  /**
+   * @brief Получить опубликованный перцептрон
+   * @details Новая версия публикуется после смены конфигурации, загрузки
+   * весов, каждой эпохи обучения и каждые snapshot_period примеров.
+   * Потокобезопасно, для распознавания из других потоков используется
+   * NetworkReplica
+   */
+  const Published<BaseNetwork> &GetPublishedNetwork() const;
+  /**
+   * @brief Начать запись отрезков выполнения
+   * @details Без опции сборки S21_PROFILE отрезки не записываются
+   */
+  static void StartTrace();
+  /**
+   * @brief Закончить запись отрезков и сохранить их в Chrome trace JSON
+   * @param path Путь до файла, пустой путь только выключает запись
+   */
+  static void SaveTrace(const std::string &path);
 
  private:
   //! Перечисление типов перцептрона
-  enum class TypeNetwork { Matrix, Graph };
+  enum class TypeNetwork { Matrix, Graph, Static };
   //! Обновить конфигурацию перцептрона
   void UpdateNetwork();
-  //! Количество слоев в перцептроне
-  std::size_t count_layers_;
-  //! Количество нейронов в скрытых слоях перцептрона
-  std::size_t count_neurons_;
+  //! Перенести веса текущего перцептрона в перцептрон выбранного типа
+  void ConvertNetwork();
+  /**
+   * @brief Опубликовать копию текущего перцептрона для других потоков
+   * @details Копии чередуются в двух буферах. Удалитель опубликованной
+   * версии отмечает буфер свободным, когда версию отпускает последний
+   * владелец, и свободный буфер перезаписывается без копирования сети
+   */
+  void Publish();
+  /**
+   * @brief Загрузить веса в статическую сеть
+   * @details Файл читается в MatrixNetwork, и если его топология поставляется
+   * статической, веса переносятся в StaticMatrixNetwork
+   * @param path Путь до файла
+   */
+  void LoadStaticWeights(std::string path);
+  /**
+   * @brief Поставить контрольную точку в очередь записи
+   * @param epoch Номер эпохи загрузчика
+   * @param skip Пройдено примеров в эпохе
+   */
+  void SaveCheckpoint(std::size_t epoch, std::size_t skip);
+  /**
+   * @brief Протестировать перцептрон на части выборки
+   * @param network Перцептрон
+   * @param reader Ридер с выборкой
+   * @param begin Индекс первого примера
+   * @param end Индекс за последним примером
+   */
+  static TestOutput Evaluate(BaseNetwork &network, const ReaderEMNIST &reader,
+                             std::size_t begin, std::size_t end);
+  /**
+   * @brief Посчитать среднюю ошибку перцептрона на выборке
+   * @param network Перцептрон
+   * @param reader Ридер с выборкой
+   */
+  static double ValidationMse(BaseNetwork &network, const ReaderEMNIST &reader);
+  //! Количество нейронов в каждом скрытом слое перцептрона
+  std::vector<std::size_t> hidden_layers_;
   //! Тип перцептрона
   TypeNetwork type_network_;
+  //! Работает ли сейчас StaticMatrixNetwork
+  bool static_engine_;
   //! Количество эпох при обучении
   std::size_t count_epoch_;
   //! Число к-валидации при обучении
@@ -105,8 +353,49 @@ class Model {
   float learning_rate_;
   //! Множитель размера тестовой выборки
   float test_sample_;
-  //! Указатель на перцептрон
-  BaseNetwork *network_;
+  //! Зерно перемешивания обучающей выборки и начальных весов
+  std::uint64_t seed_;
+  //! Схема начальной инициализации весов
+  WeightInit::Scheme weight_init_;
+  //! Перемешивать ли обучающую выборку
+  bool shuffle_;
+  //! Номер следующей эпохи загрузчика
+  std::size_t epoch_;
+  //! Номер эпохи окончания текущего обучения
+  std::size_t end_epoch_;
+  //! Пропуск примеров в начале следующей эпохи после восстановления
+  std::size_t resume_skip_;
+  //! Восстановлено ли обучение из контрольной точки
+  bool resumed_;
+  //! Искажать ли обучающие примеры
+  bool augmentation_;
+  //! Параметры искажения обучающих примеров
+  Augmentation::Options augmentation_options_;
+  //! Параметры валидации во время обучения
+  ValidationOptions validation_options_;
+  //! Перцептрон, с которым работает поток модели
+  std::unique_ptr<BaseNetwork> network_;
+  //! Опубликованные версии перцептрона
+  Published<BaseNetwork> published_;
+  //! Буфер публикуемой копии перцептрона
+  struct Snapshot {
+    //! Копия перцептрона
+    std::unique_ptr<BaseNetwork> network;
+    //! Держит ли копию опубликованная версия или читатель
+    std::atomic<bool> held{false};
+  };
+  //! Буферы публикуемых копий перцептрона, копию держит и удалитель версии
+  std::array<std::shared_ptr<Snapshot>, 2> snapshots_;
+  //! Индекс буфера следующей публикации
+  std::size_t next_snapshot_;
+  //! Период публикации весов во время обучения
+  std::size_t snapshot_period_;
+  //! Сессия инкрементального прогона
+  InferenceSession session_;
+  //! Период контрольных точек в обучающих примерах
+  std::size_t checkpoint_period_;
+  //! Фоновая запись контрольных точек
+  std::unique_ptr<CheckpointWriter> checkpoint_writer_;
 };
 
 }  // namespace s21
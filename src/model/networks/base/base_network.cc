@@ -1,5 +1,11 @@
 #include "base_network.h"
 
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include "weight_file.h"
+
 std::size_t s21::BaseNetwork::GetRightIndex(const Matrix<float> &last_layer) {
   std::size_t max_index = 0;
   float max = -1;
@@ -14,3 +20,65 @@ std::size_t s21::BaseNetwork::GetRightIndex(const Matrix<float> &last_layer) {
 }
 
 double s21::BaseNetwork::GetLastMse() const { return mse; }
+
+void s21::BaseNetwork::CheckTopology(const std::vector<std::size_t> &layers) {
+  if (layers.size() < 3) {
+    throw std::invalid_argument(
+        "The network must have at least one hidden layer.");
+  }
+  if (std::find(layers.begin(), layers.end(), 0) != layers.end()) {
+    throw std::invalid_argument("The layer size can't be zero.");
+  }
+}
+
+std::vector<std::size_t> s21::BaseNetwork::GetTopology(
+    const LayerMatrices &layers) {
+  if (layers.empty()) {
+    throw std::invalid_argument(
+        "The network must have at least one hidden layer.");
+  }
+  std::vector<std::size_t> topology{layers.front().first.GetColumns()};
+  for (const auto &[weights, biases] : layers) {
+    if (weights.GetColumns() != topology.back() ||
+        biases.GetRows() != weights.GetRows() || biases.GetColumns() != 1) {
+      throw std::invalid_argument("The layer matrices don't fit each other.");
+    }
+    topology.push_back(weights.GetRows());
+  }
+  CheckTopology(topology);
+  return topology;
+}
+
+s21::BaseNetwork::LayerMatrices s21::BaseNetwork::ReadLayerMatrices(
+    const std::string &path) {
+  if (BinaryWeightReader::IsBinary(path)) {
+    BinaryWeightReader reader{path};
+    const auto &topology = reader.GetTopology();
+    LayerMatrices layers(topology.size() - 1);
+    for (std::size_t index = 0; index < layers.size(); ++index) {
+      auto &[weights, biases] = layers[index];
+      weights.Set(topology[index + 1], topology[index]);
+      biases.Set(topology[index + 1], 1);
+      reader.ReadLayer(&weights(0, 0), &biases(0, 0));
+    }
+    return layers;
+  }
+  std::ifstream file{path};
+  std::size_t size = 0;
+  file >> size;
+  LayerMatrices layers;
+  for (std::size_t index = 0; file && index < size; ++index) {
+    Matrix<float> weights, biases;
+    file >> weights >> biases;
+    layers.emplace_back(std::move(weights), std::move(biases));
+  }
+  if (!file) {
+    throw std::invalid_argument("Bad weight file: can't read layer matrices.");
+  }
+  GetTopology(layers);
+  return layers;
+}
+
+void s21::BaseNetwork::SaveBinaryWeights(const std::string &path) const {
+  WriteBinaryWeights(path, GetLayerMatrices());
+}
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <memory>
+
 #include "../../../third-party/matrix.h"
+#include "weight_init.h"
 
 namespace s21 {
 //! Интерфейс перцептрона
 class BaseNetwork {
  public:
+  //! Пары матриц весов и смещений каждого слоя
+  typedef std::vector<std::pair<Matrix<float>, Matrix<float>>> LayerMatrices;
   //! Дефолтный конструктор
   BaseNetwork() = default;
   /**
@@ -29,14 +34,62 @@ class BaseNetwork {
   /**
    * @brief Загрузить веса
    * @param path Путь до файла
-   * @return Пара (Количество скрытых слоев, Количество нейронов в скрытом слою)
+   * @return Размеры слоев от входного до выходного
    */
-  virtual std::pair<std::size_t, std::size_t> LoadWeights(std::string path) = 0;
+  virtual std::vector<std::size_t> LoadWeights(std::string path) = 0;
   /**
    * @brief Сохранить веса
    * @param path Путь до файла
    */
   virtual void SaveWeights(std::string path) const = 0;
+  /**
+   * @brief Сохранить веса в бинарный файл
+   * @details LoadWeights узнает такой файл по сигнатуре и читает его без
+   * разбора текста
+   * @param path Путь до файла
+   */
+  void SaveBinaryWeights(const std::string &path) const;
+  /**
+   * @brief Прототип создания независимой копии перцептрона
+   * @return Указатель на копию
+   */
+  virtual std::unique_ptr<BaseNetwork> Clone() const = 0;
+  /**
+   * @brief Прототип копирования весов без выделения памяти
+   * @param other Перцептрон того же типа и тех же размеров
+   * @return false, если тип или размеры не совпадают, веса не тронуты
+   */
+  virtual bool CopyWeightsFrom(const BaseNetwork &other) = 0;
+  /**
+   * @brief Прототип выгрузки весов и смещений в матрицы
+   * @return Пары матриц весов и смещений каждого слоя
+   */
+  virtual LayerMatrices GetLayerMatrices() const = 0;
+  /**
+   * @brief Прототип загрузки весов и смещений из матриц
+   * @param layers Пары матриц весов и смещений каждого слоя
+   */
+  virtual void SetLayerMatrices(const LayerMatrices &layers) = 0;
+  /**
+   * @brief Прототип подсчета сумм первого скрытого слоя
+   * @param sensors Входные сенсоры
+   * @return Значения нейронов первого скрытого слоя до активации
+   */
+  virtual Matrix<float> GetFirstLayerSum(const Matrix<float> &sensors) = 0;
+  /**
+   * @brief Прототип добавления изменения одного сенсора в суммы первого слоя
+   * @param sum Значения нейронов первого скрытого слоя до активации
+   * @param sensor Индекс измененного сенсора
+   * @param delta Изменение значения сенсора
+   */
+  virtual void AddFirstLayerDelta(Matrix<float> &sum, std::size_t sensor,
+                                  float delta) const = 0;
+  /**
+   * @brief Прототип прогона от сумм первого скрытого слоя
+   * @param sum Значения нейронов первого скрытого слоя до активации
+   * @return Результативная матрица прогона данных по весам перцептрона
+   */
+  virtual Matrix<float> ForwardFeedFromFirstLayer(const Matrix<float> &sum) = 0;
   /**
    * @brief Получить индекс максимального значения в выходном слое
    * @param last_layer Выходной слой
@@ -45,8 +98,30 @@ class BaseNetwork {
   static std::size_t GetRightIndex(const Matrix<float> &last_layer);
   //! Получить значение средней квадратичной ошибки
   double GetLastMse() const;
+  /**
+   * @brief Проверить размеры слоев перцептрона
+   * @details Нужен хотя бы один скрытый слой, размеры слоев ненулевые
+   * @param layers Размеры слоев от входного до выходного
+   */
+  static void CheckTopology(const std::vector<std::size_t> &layers);
+  /**
+   * @brief Получить размеры слоев по матрицам весов
+   * @details Проверяет, что матрицы соседних слоев стыкуются
+   * @param layers Пары матриц весов и смещений каждого слоя
+   * @return Размеры слоев от входного до выходного
+   */
+  static std::vector<std::size_t> GetTopology(const LayerMatrices &layers);
 
  protected:
+  /**
+   * @brief Прочитать файл весов
+   * @details Текстовый файл содержит количество слоев весов и пары матриц
+   * весов и смещений, размеры каждого слоя берутся из размеров его матриц.
+   * Бинарный файл узнается по сигнатуре
+   * @param path Путь до файла
+   * @return Пары матриц весов и смещений каждого слоя
+   */
+  static LayerMatrices ReadLayerMatrices(const std::string &path);
   //! Значение средней квадратичной ошибки
   double mse = 0;
 };
@@ -0,0 +1,116 @@
+#include "weight_file.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace s21 {
+
+namespace {
+
+constexpr char magic[8] = {'S', '2', '1', 'W', 'G', 'H', 'T', '1'};
+
+// Наибольший размер слоя, больший размер считается испорченным файлом
+constexpr std::uint64_t max_layer_size = 1 << 20;
+
+template <typename T>
+void Write(std::ostream &stream, const T &value) {
+  stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T Read(std::istream &stream) {
+  T value{};
+  stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+  return value;
+}
+
+void ReadFloats(std::istream &stream, float *data, const std::size_t count) {
+  stream.read(reinterpret_cast<char *>(data),
+              static_cast<std::streamsize>(count * sizeof(float)));
+}
+
+}  // namespace
+
+BinaryWeightReader::BinaryWeightReader(const std::string &path)
+    : file_(path, std::ios::binary), path_(path), topology_(), layer_(0) {
+  char file_magic[sizeof(magic)] = {};
+  file_.read(file_magic, sizeof(file_magic));
+  if (!file_ || !std::equal(file_magic, file_magic + sizeof(magic), magic)) {
+    throw std::invalid_argument("Bad weight file: " + path_);
+  }
+  const auto size = Read<std::uint64_t>(file_);
+  if (!file_ || size > max_layer_size) {
+    throw std::invalid_argument("Bad weight file: " + path_);
+  }
+  for (std::uint64_t index = 0; index < size; ++index) {
+    const auto layer = Read<std::uint64_t>(file_);
+    if (!file_ || layer > max_layer_size) {
+      throw std::invalid_argument("Bad weight file: wrong layer size.");
+    }
+    topology_.push_back(layer);
+  }
+  BaseNetwork::CheckTopology(topology_);
+  std::uint64_t floats = 0;
+  for (std::size_t index = 0; (index + 1) < topology_.size(); ++index) {
+    floats += (topology_[index] + 1) * topology_[index + 1];
+  }
+  const auto begin = file_.tellg();
+  file_.seekg(0, std::ios::end);
+  const auto end = file_.tellg();
+  file_.seekg(begin);
+  if (!file_ || static_cast<std::uint64_t>(end - begin) !=
+                    floats * sizeof(float)) {
+    throw std::invalid_argument(
+        "Bad weight file: size doesn't match the layers in " + path_);
+  }
+}
+
+bool BinaryWeightReader::IsBinary(const std::string &path) {
+  std::ifstream file{path, std::ios::binary};
+  char file_magic[sizeof(magic)] = {};
+  file.read(file_magic, sizeof(file_magic));
+  return file && std::equal(file_magic, file_magic + sizeof(magic), magic);
+}
+
+const std::vector<std::size_t> &BinaryWeightReader::GetTopology()
+    const noexcept {
+  return topology_;
+}
+
+void BinaryWeightReader::ReadLayer(float *weights, float *biases) {
+  if (layer_ + 1 >= topology_.size()) {
+    throw std::out_of_range("All layers of the weight file are read.");
+  }
+  const std::size_t rows = topology_[layer_ + 1], cols = topology_[layer_];
+  ReadFloats(file_, weights, rows * cols);
+  ReadFloats(file_, biases, rows);
+  if (!file_) {
+    throw std::invalid_argument("Bad weight file: truncated " + path_);
+  }
+  ++layer_;
+}
+
+void WriteBinaryWeights(const std::string &path,
+                        const BaseNetwork::LayerMatrices &layers) {
+  const auto topology = BaseNetwork::GetTopology(layers);
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  file.write(magic, sizeof(magic));
+  Write<std::uint64_t>(file, topology.size());
+  for (const std::size_t size : topology) {
+    Write<std::uint64_t>(file, size);
+  }
+  for (const auto &[weights, biases] : layers) {
+    file.write(reinterpret_cast<const char *>(&weights(0, 0)),
+               static_cast<std::streamsize>(weights.GetRows() *
+                                            weights.GetColumns() *
+                                            sizeof(float)));
+    file.write(reinterpret_cast<const char *>(&biases(0, 0)),
+               static_cast<std::streamsize>(biases.GetRows() * sizeof(float)));
+  }
+  file.close();
+  if (!file) {
+    throw std::runtime_error("Can't write weight file: " + path);
+  }
+}
+
+}  // namespace s21
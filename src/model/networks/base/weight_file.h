@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "base_network.h"
+
+namespace s21 {
+
+/**
+ * @brief Последовательное чтение бинарного файла весов
+ * @details Файл начинается с сигнатуры, количества слоев и размеров всех
+ * слоев, поэтому сеть можно построить до чтения весов. Дальше для каждого
+ * слоя лежат веса по строкам и смещения в виде float. Размер файла
+ * сверяется с заголовком при открытии, до чтения весов
+ */
+class BinaryWeightReader {
+ public:
+  /**
+   * @brief Открыть файл и прочитать заголовок
+   * @details Бросает исключение, если заголовок испорчен или размер файла
+   * не совпадает с размерами слоев
+   * @param path Путь до файла
+   */
+  explicit BinaryWeightReader(const std::string &path);
+  /**
+   * @brief Проверить сигнатуру бинарного файла весов
+   * @param path Путь до файла
+   * @return Бинарный ли файл
+   */
+  static bool IsBinary(const std::string &path);
+  //! Получить размеры слоев от входного до выходного
+  const std::vector<std::size_t> &GetTopology() const noexcept;
+  /**
+   * @brief Прочитать следующий слой весов
+   * @param weights Веса слоя по строкам, размер следующего слоя на размер
+   * предыдущего
+   * @param biases Смещения слоя, размер следующего слоя
+   */
+  void ReadLayer(float *weights, float *biases);
+
+ private:
+  //! Файл весов
+  std::ifstream file_;
+  //! Путь до файла для сообщений об ошибках
+  std::string path_;
+  //! Размеры слоев из заголовка
+  std::vector<std::size_t> topology_;
+  //! Индекс следующего читаемого слоя
+  std::size_t layer_;
+};
+
+/**
+ * @brief Записать веса и смещения в бинарный файл
+ * @param path Путь до файла
+ * @param layers Пары матриц весов и смещений каждого слоя
+ */
+void WriteBinaryWeights(const std::string &path,
+                        const BaseNetwork::LayerMatrices &layers);
+
+}  // namespace s21
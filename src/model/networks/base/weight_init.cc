@@ -0,0 +1,104 @@
+#include "weight_init.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+namespace {
+
+// Элементов на поток, меньшие слои заполняются в текущем потоке
+constexpr std::size_t min_thread_elements = 1 << 16;
+
+// Перевести старшие 24 бита в число из (0, 1]
+float OpenUnit(const std::uint32_t value) {
+  return static_cast<float>((value >> 8) + 1) * 0x1.0p-24f;
+}
+
+// Заполнить элементы [begin, end), begin кратно четырем
+void FillRange(float *weights, const std::size_t rows, const std::size_t cols,
+               const std::size_t layer, const WeightInit &init,
+               const bool column_major, const std::size_t begin,
+               const std::size_t end) {
+  const std::array<std::uint32_t, 2> key{
+      static_cast<std::uint32_t>(init.seed),
+      static_cast<std::uint32_t>(init.seed >> 32)};
+  const float xavier = std::sqrt(6.f / static_cast<float>(rows + cols));
+  const float he = std::sqrt(2.f / static_cast<float>(cols));
+  constexpr float two_pi = 6.28318530718f;
+  for (std::size_t block = begin; block < end; block += 4) {
+    const std::uint64_t counter = block / 4;
+    const auto bits =
+        Philox({static_cast<std::uint32_t>(counter),
+                static_cast<std::uint32_t>(counter >> 32),
+                static_cast<std::uint32_t>(layer), 0},
+               key);
+    std::array<float, 4> values;
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+      values[lane] = OpenUnit(bits[lane]) * 2.f - 1.f;
+    }
+    if (init.scheme == WeightInit::Scheme::Xavier) {
+      for (auto &value : values) {
+        value *= xavier;
+      }
+    } else if (init.scheme == WeightInit::Scheme::He) {
+      for (std::size_t lane = 0; lane < 4; lane += 2) {
+        const float radius =
+            he * std::sqrt(-2.f * std::log(OpenUnit(bits[lane])));
+        const float angle = two_pi * OpenUnit(bits[lane + 1]);
+        values[lane] = radius * std::cos(angle);
+        values[lane + 1] = radius * std::sin(angle);
+      }
+    }
+    for (std::size_t index = block; index < std::min(block + 4, end);
+         ++index) {
+      const std::size_t row = index / cols, col = index % cols;
+      weights[column_major ? col * rows + row : index] = values[index - block];
+    }
+  }
+}
+
+}  // namespace
+
+std::array<std::uint32_t, 4> Philox(std::array<std::uint32_t, 4> counter,
+                                    std::array<std::uint32_t, 2> key) {
+  for (std::size_t round = 0; round < 10; ++round) {
+    const std::uint64_t first = 0xD2511F53ull * counter[0],
+                        second = 0xCD9E8D57ull * counter[2];
+    counter = {static_cast<std::uint32_t>(second >> 32) ^ counter[1] ^ key[0],
+               static_cast<std::uint32_t>(second),
+               static_cast<std::uint32_t>(first >> 32) ^ counter[3] ^ key[1],
+               static_cast<std::uint32_t>(first)};
+    key[0] += 0x9E3779B9u;
+    key[1] += 0xBB67AE85u;
+  }
+  return counter;
+}
+
+void FillWeights(float *weights, const std::size_t rows,
+                 const std::size_t cols, const std::size_t layer,
+                 const WeightInit &init, const bool column_major,
+                 std::size_t count_threads) {
+  const std::size_t size = rows * cols;
+  if (count_threads == 0) {
+    count_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  count_threads =
+      std::max(std::min(count_threads, size / min_thread_elements), 1lu);
+  const std::size_t chunk = (size / count_threads + 3) / 4 * 4;
+  std::vector<std::thread> threads;
+  for (std::size_t begin = chunk; begin < size; begin += chunk) {
+    threads.emplace_back(FillRange, weights, rows, cols, layer,
+                         std::cref(init), column_major, begin,
+                         std::min(begin + chunk, size));
+  }
+  FillRange(weights, rows, cols, layer, init, column_major, 0,
+            std::min(chunk, size));
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace s21 {
+
+//! Параметры начальной инициализации весов
+struct WeightInit {
+  //! Схема инициализации
+  enum class Scheme {
+    Uniform,  //!< Равномерно из (-1, 1]
+    Xavier,   //!< Равномерно по Глороту, для сигмоиды и tanh
+    He        //!< Нормально по Хе, для ReLU
+  };
+  std::uint64_t seed = 0;          //!< Зерно генератора
+  Scheme scheme = Scheme::Uniform;  //!< Схема инициализации
+};
+
+/**
+ * @brief Счетчиковый генератор Philox4x32-10
+ * @details Результат зависит только от счетчика и ключа, поэтому любой
+ * элемент последовательности считается независимо от остальных
+ * @param counter Счетчик
+ * @param key Ключ
+ * @return Четыре случайных 32-битных значения
+ */
+std::array<std::uint32_t, 4> Philox(std::array<std::uint32_t, 4> counter,
+                                    std::array<std::uint32_t, 2> key);
+
+/**
+ * @brief Заполнить веса слоя начальными значениями
+ * @details Вес (row, col) зависит только от зерна, номера слоя и своего
+ * индекса row * cols + col, поэтому результат не зависит от количества
+ * потоков и порядка хранения. Большие слои заполняются параллельно
+ * @param weights Веса слоя
+ * @param rows Количество строк, размер следующего слоя
+ * @param cols Количество столбцов, размер предыдущего слоя
+ * @param layer Номер слоя весов
+ * @param init Параметры инициализации
+ * @param column_major Хранятся ли веса по столбцам
+ * @param count_threads Количество потоков, 0 - по числу ядер
+ */
+void FillWeights(float *weights, std::size_t rows, std::size_t cols,
+                 std::size_t layer, const WeightInit &init,
+                 bool column_major = false, std::size_t count_threads = 0);
+
+}  // namespace s21
@@ -1,18 +1,23 @@
 #include "graph_network.h"
 
 #include <cmath>
+#include <algorithm>
 #include <fstream>
-#include <random>
+#include <thread>
 #include <vector>
 
+#include "../../profiler/profiler.h"
+#include "../../profiler/tracer.h"
+#include "../base/weight_file.h"
+
 namespace s21 {
 
-GraphNetwork::Weight::Weight(Neuron &child) : target(child) {
-  static std::random_device rd;
-  static std::mt19937 mt(rd());
-  static std::uniform_real_distribution<float> dist(-1.0, 1.0);
-  weight = dist(mt);
-}
+namespace {
+
+// Связей на поток при заполнении широких слоев
+constexpr std::size_t min_thread_edges = 1 << 16;
+
+}  // namespace
 
 GraphNetwork::Weight::Weight(Neuron &child, float _weight)
     : target(child), weight(_weight) {}
@@ -32,6 +37,15 @@ void GraphNetwork::Layer::SendValues() {
   }
 }
 
+void GraphNetwork::Layer::SendValues(const std::vector<std::size_t> &active) {
+  for (const std::size_t index : active) {
+    Neuron &neuron = neurons[index];
+    for (Weight &weight : neuron.weights) {
+      weight.AddValue(neuron.value);
+    }
+  }
+}
+
 void GraphNetwork::Layer::Sigmoid() {
   for (Neuron &neuron : neurons) {
     neuron.value = 1.f / (1.f + std::exp(-neuron.value));
@@ -63,6 +77,18 @@ void GraphNetwork::Layer::FixWeight(float learning_rate) {
   }
 }
 
+void GraphNetwork::Layer::FixWeight(float learning_rate,
+                                     const std::vector<std::size_t> &active) {
+  for (const std::size_t index : active) {
+    auto &neuron = neurons[index];
+    const float learning_value = neuron.value * learning_rate;
+    for (auto &weight : neuron.weights) {
+      const float error = learning_value * weight.target.error;
+      weight.weight += error;
+    }
+  }
+}
+
 void GraphNetwork::Layer::FixBias(float learning_rate) {
   for (auto &neuron : neurons) {
     neuron.bias += neuron.error * learning_rate;
@@ -75,22 +101,39 @@ void GraphNetwork::Layer::ClearValues() {
   }
 }
 
-GraphNetwork::GraphNetwork(const std::vector<std::size_t> &layers) {
-  if (layers.size() < 4 || layers.size() > 7) {
-    throw std::invalid_argument("The network size must be between 2 and 5.");
+GraphNetwork::GraphNetwork(const std::vector<std::size_t> &layers,
+                           const WeightInit &init) {
+  CheckTopology(layers);
+  Build(layers);
+  std::vector<float> weights;
+  for (std::size_t layer = 0; (layer + 1) < layers_.size(); ++layer) {
+    weights.resize(layers[layer + 1] * layers[layer]);
+    FillWeights(weights.data(), layers[layer + 1], layers[layer], layer,
+                init);
+    SetLayerWeights(layer, weights.data());
   }
-  layers_.emplace_back(layers.front());
-  for (std::size_t index = 1; index < layers.size(); ++index) {
-    layers_.emplace_back(layers[index]);
-    for (auto &parent : layers_[index - 1].neurons) {
-      for (auto &child : layers_[index].neurons) {
-        parent.weights.emplace_back(child);
-      }
-    }
+}
+
+GraphNetwork::GraphNetwork(const LayerMatrices &layers) {
+  SetLayerMatrices(layers);
+}
+
+GraphNetwork::GraphNetwork(const GraphNetwork &other)
+    : BaseNetwork(other), layers_(), active_sensors_() {
+  Build(other.GetSizes());
+  CopyWeightsFrom(other);
+}
+
+GraphNetwork &GraphNetwork::operator=(const GraphNetwork &other) {
+  if (this != &other && !CopyWeightsFrom(other)) {
+    *this = GraphNetwork(other);
   }
+  mse = other.mse;
+  return *this;
 }
 
 Matrix<float> GraphNetwork::ForwardFeed(const Matrix<float> &sensors) {
+  S21_TRACE_SCOPE("GraphNetwork::ForwardFeed");
   InitFullWay(sensors);
   auto last_layer = FromNeuronsToMatrix(layers_.back().neurons);
   ClearValues();
@@ -99,50 +142,92 @@ Matrix<float> GraphNetwork::ForwardFeed(const Matrix<float> &sensors) {
 
 void GraphNetwork::Learn(const Matrix<float> &sensors, const std::size_t answer,
                          const float learning_rate) {
+  S21_TRACE_SCOPE("GraphNetwork::Learn");
   InitFullWay(sensors);
   BackPropagation(answer, learning_rate);
   auto last_layer = FromNeuronsToMatrix(layers_.back().neurons);
   ClearValues();
 }
 
-std::pair<std::size_t, std::size_t> GraphNetwork::LoadWeights(
-    std::string path) {
-  std::ifstream file{path};
-  std::size_t size = 0;
-  file >> size;
-  if (size < 3 || size > 6) {
-    throw std::invalid_argument("The network size must be between 2 and 5.");
+std::vector<std::size_t> GraphNetwork::LoadWeights(std::string path) {
+  S21_TRACE_SCOPE("GraphNetwork::LoadWeights");
+  S21_PROFILE_SCOPE(Serialize);
+  if (!BinaryWeightReader::IsBinary(path)) {
+    const auto layers = ReadLayerMatrices(path);
+    SetLayerMatrices(layers);
+    return GetTopology(layers);
   }
-  std::vector<std::pair<Matrix<float>, Matrix<float>>> layers;
-  layers.resize(size);
-  for (auto &[weights, bias] : layers) {
-    file >> weights >> bias;
+  // Заголовок уже сверен с размером файла, поэтому веса читаются сразу в
+  // связи нового графа. Старый граф возвращается, если чтение все же упадет
+  BinaryWeightReader reader{path};
+  const auto topology = reader.GetTopology();
+  auto previous = std::move(layers_);
+  try {
+    Build(topology);
+    std::vector<float> weights, biases;
+    for (std::size_t layer = 0; (layer + 1) < topology.size(); ++layer) {
+      weights.resize(topology[layer + 1] * topology[layer]);
+      biases.resize(topology[layer + 1]);
+      reader.ReadLayer(weights.data(), biases.data());
+      SetLayerWeights(layer, weights.data());
+      auto &children = layers_[layer + 1].neurons;
+      for (std::size_t child = 0; child < children.size(); ++child) {
+        children[child].bias = biases[child];
+      }
+    }
+  } catch (...) {
+    layers_ = std::move(previous);
+    throw;
+  }
+  return topology;
+}
+
+void GraphNetwork::SaveWeights(std::string path) const {
+  S21_TRACE_SCOPE("GraphNetwork::SaveWeights");
+  S21_PROFILE_SCOPE(Serialize);
+  const auto neurons_to_save = GetLayerMatrices();
+  std::ofstream file{path};
+  file << neurons_to_save.size() << '\n';
+  for (auto &[weights, bias] : neurons_to_save) {
+    file << weights << bias;
   }
   file.close();
-  if (!file.bad()) {
-    layers_.clear();
-    layers_.emplace_back(layers.front().first.GetColumns());
-    for (std::size_t layer = 0; layer < layers.size(); ++layer) {
-      layers_.emplace_back(layers[layer].first.GetRows());
-      for (std::size_t child = 0; child < layers_[layer + 1].neurons.size();
-           ++child) {
-        auto &child_neiron = layers_[layer + 1].neurons[child];
-        for (std::size_t parent = 0; parent < layers_[layer].neurons.size();
-             ++parent) {
-          auto &parent_neiron = layers_[layer].neurons[parent];
-          parent_neiron.weights.emplace_back(
-              child_neiron, layers[layer].first(child, parent));
-        }
-        child_neiron.bias = layers[layer].second(child, 0);
+}
+
+std::unique_ptr<BaseNetwork> GraphNetwork::Clone() const {
+  return std::make_unique<GraphNetwork>(*this);
+}
+
+bool GraphNetwork::CopyWeightsFrom(const BaseNetwork &other) {
+  const auto *network = dynamic_cast<const GraphNetwork *>(&other);
+  if (!network || network->layers_.size() != layers_.size()) {
+    return false;
+  }
+  for (std::size_t layer = 0; layer < layers_.size(); ++layer) {
+    const auto &source = network->layers_[layer].neurons;
+    if (source.size() != layers_[layer].neurons.size() ||
+        source.front().weights.size() !=
+            layers_[layer].neurons.front().weights.size()) {
+      return false;
+    }
+  }
+  for (std::size_t layer = 0; layer < layers_.size(); ++layer) {
+    auto &neurons = layers_[layer].neurons;
+    const auto &source = network->layers_[layer].neurons;
+    for (std::size_t index = 0; index < neurons.size(); ++index) {
+      neurons[index].bias = source[index].bias;
+      for (std::size_t weight = 0; weight < neurons[index].weights.size();
+           ++weight) {
+        neurons[index].weights[weight].weight =
+            source[index].weights[weight].weight;
       }
     }
   }
-  return {layers_.size() - 2, layers_[1].neurons.size()};
+  return true;
 }
 
-void GraphNetwork::SaveWeights(std::string path) const {
-  std::vector<std::pair<Matrix<float>, Matrix<float>>> neurons_to_save(
-      layers_.size() - 1);
+GraphNetwork::LayerMatrices GraphNetwork::GetLayerMatrices() const {
+  LayerMatrices neurons_to_save(layers_.size() - 1);
   for (std::size_t index = 0; (index + 1) < layers_.size(); ++index) {
     const std::size_t size_cols = layers_[index].neurons.size();
     const std::size_t size_rows = layers_[index + 1].neurons.size();
@@ -159,43 +244,158 @@ void GraphNetwork::SaveWeights(std::string path) const {
           layers_[index + 1].neurons[rows].bias;
     }
   }
-  std::ofstream file{path};
-  file << neurons_to_save.size() << '\n';
-  for (auto &[weights, bias] : neurons_to_save) {
-    file << weights << bias;
+  return neurons_to_save;
+}
+
+void GraphNetwork::SetLayerMatrices(const LayerMatrices &layers) {
+  Build(GetTopology(layers));
+  for (std::size_t layer = 0; layer < layers.size(); ++layer) {
+    const auto &[weights, bias] = layers[layer];
+    SetLayerWeights(layer, &weights(0, 0));
+    auto &children = layers_[layer + 1].neurons;
+    for (std::size_t child = 0; child < children.size(); ++child) {
+      children[child].bias = bias(child, 0);
+    }
   }
-  file.close();
 }
 
-void GraphNetwork::InitFullWay(const Matrix<float> &sensors) {
+void GraphNetwork::Build(const std::vector<std::size_t> &layers) {
+  layers_.clear();
+  layers_.reserve(layers.size());
+  for (const std::size_t size : layers) {
+    layers_.emplace_back(size);
+  }
+  for (std::size_t layer = 0; (layer + 1) < layers_.size(); ++layer) {
+    auto &[parents, edges] = layers_[layer];
+    auto &children = layers_[layer + 1].neurons;
+    edges.reserve(parents.size() * children.size());
+    for (auto &parent : parents) {
+      parent.weights = {edges.data() + edges.size(), children.size()};
+      for (auto &child : children) {
+        edges.emplace_back(child, 0.f);
+      }
+    }
+  }
+}
+
+void GraphNetwork::SetLayerWeights(const std::size_t layer,
+                                   const float *weights) {
+  auto &parents = layers_[layer].neurons;
+  const std::size_t cols = parents.size(),
+                    rows = layers_[layer + 1].neurons.size();
+  auto fill = [&](const std::size_t begin, const std::size_t end) {
+    for (std::size_t parent = begin; parent < end; ++parent) {
+      auto &edges = parents[parent].weights;
+      for (std::size_t child = 0; child < rows; ++child) {
+        edges[child].weight = weights[child * cols + parent];
+      }
+    }
+  };
+  const std::size_t count_threads = std::min<std::size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u),
+      std::max(rows * cols / min_thread_edges, 1lu));
+  const std::size_t chunk = (cols + count_threads - 1) / count_threads;
+  std::vector<std::thread> threads;
+  for (std::size_t begin = chunk; begin < cols; begin += chunk) {
+    threads.emplace_back(fill, begin, std::min(begin + chunk, cols));
+  }
+  fill(0, std::min(chunk, cols));
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+std::vector<std::size_t> GraphNetwork::GetSizes() const {
+  std::vector<std::size_t> sizes;
+  sizes.reserve(layers_.size());
+  for (const auto &layer : layers_) {
+    sizes.push_back(layer.neurons.size());
+  }
+  return sizes;
+}
+
+Matrix<float> GraphNetwork::GetFirstLayerSum(const Matrix<float> &sensors) {
+  InitSensors(sensors);
+  layers_[0].SendValues(active_sensors_);
+  layers_[1].AddBias();
+  auto sum = FromNeuronsToMatrix(layers_[1].neurons);
+  ClearValues();
+  return sum;
+}
+
+void GraphNetwork::AddFirstLayerDelta(Matrix<float> &sum, std::size_t sensor,
+                                      const float delta) const {
+  const auto &weights = layers_[0].neurons[sensor].weights;
+  for (std::size_t child = 0; child < weights.size(); ++child) {
+    sum(child, 0) += weights[child].weight * delta;
+  }
+}
+
+Matrix<float> GraphNetwork::ForwardFeedFromFirstLayer(
+    const Matrix<float> &sum) {
+  S21_PROFILE_SCOPE(Forward);
+  for (std::size_t i = 0; i < layers_[1].neurons.size(); ++i) {
+    layers_[1].neurons[i].value = sum(i, 0);
+  }
+  layers_[1].Sigmoid();
+  FeedFrom(1);
+  auto last_layer = FromNeuronsToMatrix(layers_.back().neurons);
+  ClearValues();
+  return last_layer;
+}
+
+void GraphNetwork::InitSensors(const Matrix<float> &sensors) {
+  active_sensors_.clear();
   for (std::size_t i = 0; i < layers_[0].neurons.size(); ++i) {
     layers_[0].neurons[i].value = sensors(i, 0);
+    if (layers_[0].neurons[i].value != 0.f) {
+      active_sensors_.push_back(i);
+    }
   }
-  for (std::size_t i = 0; (i + 1) < layers_.size(); ++i) {
+}
+
+void GraphNetwork::FeedFrom(const std::size_t layer) {
+  for (std::size_t i = layer; (i + 1) < layers_.size(); ++i) {
     layers_[i].SendValues();
     layers_[i + 1].AddBias();
     layers_[i + 1].Sigmoid();
   }
 }
 
+void GraphNetwork::InitFullWay(const Matrix<float> &sensors) {
+  S21_PROFILE_SCOPE(Forward);
+  InitSensors(sensors);
+  layers_[0].SendValues(active_sensors_);
+  layers_[1].AddBias();
+  layers_[1].Sigmoid();
+  FeedFrom(1);
+}
+
 void GraphNetwork::BackPropagation(const std::size_t answer,
                                    const float learning_rate) {
   if (answer > 25) {
     throw std::invalid_argument("Bad EMNIST: answer letter is out of index");
   }
   std::size_t current = layers_.size() - 1;
-  auto &last_layer = layers_[current].neurons;
-  mse = 0.f;
-  for (std::size_t neuron = 0; neuron < last_layer.size(); ++neuron) {
-    const float value = last_layer[neuron].value;
-    const float isAnswer = (neuron == answer ? 1.f : 0.f);
-    const float error = value * (1 - value) * (isAnswer - value);
-    last_layer[neuron].error = error;
-    mse += powf(isAnswer - value, 2);
-  }
-  while (--current > 0) {
-    layers_[current].TakeError();
+  {
+    S21_PROFILE_SCOPE(Backward);
+    auto &last_layer = layers_[current].neurons;
+    mse = 0.f;
+    for (std::size_t neuron = 0; neuron < last_layer.size(); ++neuron) {
+      const float value = last_layer[neuron].value;
+      const float isAnswer = (neuron == answer ? 1.f : 0.f);
+      const float error = value * (1 - value) * (isAnswer - value);
+      last_layer[neuron].error = error;
+      mse += powf(isAnswer - value, 2);
+    }
+    while (--current > 0) {
+      layers_[current].TakeError();
+    }
   }
+  S21_PROFILE_SCOPE(Update);
+  layers_[0].FixWeight(learning_rate, active_sensors_);
+  layers_[1].FixBias(learning_rate);
+  ++current;
   while (++current < layers_.size()) {
     layers_[current - 1].FixWeight(learning_rate);
     layers_[current].FixBias(learning_rate);
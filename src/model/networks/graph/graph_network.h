@@ -12,14 +12,31 @@ class GraphNetwork final : public BaseNetwork {
    * @brief Конструктор с заданными слоями
    * @details Создает слои размером каждого значения вектора
    * @param layers Вектор размеров слоев
+   * @param init Параметры начальной инициализации весов
    */
-  explicit GraphNetwork(const std::vector<std::size_t> &layers);
-  //! Дефолтный конструктор копирования
-  GraphNetwork(const GraphNetwork &a) = default;
+  explicit GraphNetwork(const std::vector<std::size_t> &layers,
+                 const WeightInit &init = {});
+  /**
+   * @brief Конструктор по матрицам весов и смещений
+   * @param layers Пары матриц весов и смещений каждого слоя
+   */
+  explicit GraphNetwork(const LayerMatrices &layers);
+  /**
+   * @brief Конструктор копирования
+   * @details Связи копии ведут на ее собственные нейроны, память под все
+   * нейроны и связи выделяется заранее
+   * @param other Исходный перцептрон
+   */
+  GraphNetwork(const GraphNetwork &other);
   //! Дефолтный конструктор переноса
   GraphNetwork(GraphNetwork &&a) noexcept = default;
-  //! Дефолтный конструктор копирования
-  GraphNetwork &operator=(const GraphNetwork &) = default;
+  /**
+   * @brief Оператор копирования
+   * @details При совпадении размеров копирует только веса и смещения
+   * @param other Исходный перцептрон
+   * @return Ссылка на себя
+   */
+  GraphNetwork &operator=(const GraphNetwork &other);
   //! Дефолтный конструктор переноса
   GraphNetwork &operator=(GraphNetwork &&) noexcept = default;
   //! Переопределение дефолтного контруктора
@@ -40,33 +57,87 @@ class GraphNetwork final : public BaseNetwork {
              float learning_rate) override;
   /**
    * @brief Загрузить веса
+   * @details Бинарный файл читается слой за слоем прямо в связи нового
+   * графа, без промежуточных матриц. Текстовый сначала разбирается целиком.
+   * При ошибке остается прежний граф
    * @param path Путь до файла
-   * @return Пара (Количество скрытых слоев, Количество нейронов в скрытом слою)
+   * @return Размеры слоев от входного до выходного
    */
-  std::pair<std::size_t, std::size_t> LoadWeights(std::string path) override;
+  std::vector<std::size_t> LoadWeights(std::string path) override;
   /**
    * @brief Сохранить веса
    * @param path Путь до файла
    */
   void SaveWeights(std::string path) const override;
+  /**
+   * @brief Создать независимую копию перцептрона
+   * @return Указатель на копию
+   */
+  std::unique_ptr<BaseNetwork> Clone() const override;
+  /**
+   * @brief Скопировать веса и смещения без выделения памяти
+   * @param other Графовый перцептрон тех же размеров
+   * @return false, если тип или размеры не совпадают
+   */
+  bool CopyWeightsFrom(const BaseNetwork &other) override;
+  /**
+   * @brief Выгрузить веса и смещения в матрицы
+   * @return Пары матриц весов и смещений каждого слоя
+   */
+  LayerMatrices GetLayerMatrices() const override;
+  /**
+   * @brief Загрузить веса и смещения из матриц
+   * @param layers Пары матриц весов и смещений каждого слоя
+   */
+  void SetLayerMatrices(const LayerMatrices &layers) override;
+  /**
+   * @brief Подсчитать суммы первого скрытого слоя
+   * @param sensors Входные сенсоры
+   * @return Значения нейронов первого скрытого слоя до активации
+   */
+  Matrix<float> GetFirstLayerSum(const Matrix<float> &sensors) override;
+  /**
+   * @brief Добавить изменение одного сенсора в суммы первого слоя
+   * @param sum Значения нейронов первого скрытого слоя до активации
+   * @param sensor Индекс измененного сенсора
+   * @param delta Изменение значения сенсора
+   */
+  void AddFirstLayerDelta(Matrix<float> &sum, std::size_t sensor,
+                          float delta) const override;
+  /**
+   * @brief Прогнать от сумм первого скрытого слоя
+   * @param sum Значения нейронов первого скрытого слоя до активации
+   * @return Результативная матрица прогона данных по весам перцептрона
+   */
+  Matrix<float> ForwardFeedFromFirstLayer(const Matrix<float> &sum) override;
 
  private:
   //! Предварительная декларация класса связи между нейронами
   struct Weight;
+  //! Связи нейрона, лежащие подряд в общем массиве связей слоя
+  struct Edges {
+    //! Начало связей
+    Weight *begin() const noexcept { return data; }
+    //! Конец связей
+    Weight *end() const noexcept { return data + count; }
+    //! Связь с заданным нейроном следующего слоя
+    Weight &operator[](std::size_t index) const noexcept {
+      return data[index];
+    }
+    //! Количество связей
+    std::size_t size() const noexcept { return count; }
+    Weight *data = nullptr;  //!< Первая связь
+    std::size_t count = 0;   //!< Количество связей
+  };
   //! Нейрон
   struct Neuron {
-    float value = 0;              //!< Значение
-    float error = 0;              //!< Ошибка
-    float bias = 0;               //!< Смещение
-    std::vector<Weight> weights;  //!< Веса на следующие нейроны
+    float value = 0;  //!< Значение
+    float error = 0;  //!< Ошибка
+    float bias = 0;   //!< Смещение
+    Edges weights;    //!< Веса на следующие нейроны
   };
   //! Класс связи между нейронами
   struct Weight {
-    /**
-     * @brief Конструктор веса связывающий следующий нейрон
-     * @param neuron Следующий нейрон
-     */
-    explicit Weight(Neuron &neuron);
     //! Дефолтный конструктор копирования
     Weight(const Weight &a) = default;
     //! Дефолтный конструктор переноса
@@ -99,18 +170,23 @@ class GraphNetwork final : public BaseNetwork {
      * @param neurons Заданное количество нейронов
      */
     explicit Layer(std::size_t neurons);
-    //! Дефолтный конструктор копирования
-    Layer(const Layer &a) = default;
+    //! Удален конструктор копирования, связи ведут на нейроны исходника
+    Layer(const Layer &a) = delete;
     //! Дефолтный конструктор переноса
     Layer(Layer &&a) noexcept = default;
-    //! Дефолтный конструктор копирования
-    Layer &operator=(const Layer &) = default;
+    //! Удален оператор копирования
+    Layer &operator=(const Layer &) = delete;
     //! Дефолтный конструктор переноса
     Layer &operator=(Layer &&) noexcept = default;
     //! Дефолтный деструктор
     ~Layer() = default;
     //! Отправить значения дальше по весам
     void SendValues();
+    /**
+     * @brief Отправить дальше по весам значения только заданных нейронов
+     * @param active Индексы нейронов с ненулевыми значениями
+     */
+    void SendValues(const std::vector<std::size_t> &active);
     //! Собрать значения из нейронов впереди
     void TakeError();
     //! Взять сигмоиду каждого нейрона
@@ -122,6 +198,12 @@ class GraphNetwork final : public BaseNetwork {
      * @param learning_rate Скорость обучения
      */
     void FixWeight(float learning_rate);
+    /**
+     * @brief Скоректировать веса только заданных нейронов
+     * @param learning_rate Скорость обучения
+     * @param active Индексы нейронов с ненулевыми значениями
+     */
+    void FixWeight(float learning_rate, const std::vector<std::size_t> &active);
     /**
      * @brief Скоректировать смещение по ошибке
      * @param learning_rate Скорость обучения
@@ -130,6 +212,7 @@ class GraphNetwork final : public BaseNetwork {
     //! Очистить значения и ошибки нейронов
     void ClearValues();
     std::vector<Neuron> neurons;  //!< Нейроны
+    std::vector<Weight> edges;    //!< Связи всех нейронов подряд
   };
   /**
    * @brief Перевод нейронов в матрицу
@@ -137,11 +220,37 @@ class GraphNetwork final : public BaseNetwork {
    * @return Матрица переведенная из нейронов
    */
   static Matrix<float> FromNeuronsToMatrix(const std::vector<Neuron> &neurons);
+  /**
+   * @brief Создать слои и связать соседние нулевыми весами
+   * @details Связи слоя лежат в одном массиве, память под который
+   * выделяется заранее, поэтому ссылки на нейроны и связи не инвалидируются
+   * @param layers Размеры слоев от входного до выходного
+   */
+  void Build(const std::vector<std::size_t> &layers);
+  /**
+   * @brief Записать веса слоя, для широких слоев параллельно
+   * @param layer Номер слоя весов
+   * @param weights Веса по строкам, размер следующего слоя на размер
+   * текущего
+   */
+  void SetLayerWeights(std::size_t layer, const float *weights);
+  //! Получить размеры слоев от входного до выходного
+  std::vector<std::size_t> GetSizes() const;
   /**
    * @brief Прогнать все значения по сети
    * @param sensors Входные сенсоры
    */
   void InitFullWay(const Matrix<float> &sensors);
+  /**
+   * @brief Записать сенсоры во входной слой и собрать ненулевые индексы
+   * @param sensors Входные сенсоры
+   */
+  void InitSensors(const Matrix<float> &sensors);
+  /**
+   * @brief Прогнать значения от заданного слоя до выходного
+   * @param layer Индекс слоя с уже посчитанными значениями
+   */
+  void FeedFrom(std::size_t layer);
   /**
    * @brief Выполнить обратное распространение ошибок
    * @param answer Правильный выходной индекс
@@ -152,6 +261,8 @@ class GraphNetwork final : public BaseNetwork {
   void ClearValues();
   //! Слои сети
   std::vector<Layer> layers_;
+  //! Индексы ненулевых входных сенсоров текущего прогона
+  std::vector<std::size_t> active_sensors_;
 };
 
 }  // namespace s21
@@ -1,7 +1,9 @@
 #include "matrix_network.h"
 
 #include <fstream>
-#include <random>
+
+#include "../../profiler/profiler.h"
+#include "../../profiler/tracer.h"
 
 namespace s21 {
 
@@ -9,47 +11,52 @@ MatrixNetwork::Layer::Layer(std::size_t weight_rows, std::size_t weight_cols,
                             std::size_t bias_rows, std::size_t bias_cols)
     : weights(weight_rows, weight_cols), biases(bias_rows, bias_cols) {}
 
-MatrixNetwork::MatrixNetwork(const std::vector<std::size_t> &layers) {
-  if (layers.size() < 4 || layers.size() > 7) {
-    throw std::invalid_argument("The network size must be between 2 and 5.");
-  }
+MatrixNetwork::MatrixNetwork(const std::vector<std::size_t> &layers,
+                             const WeightInit &init) {
+  CheckTopology(layers);
   for (std::size_t index = 1; index < layers.size(); ++index) {
     layers_.emplace_back(layers[index], layers[index - 1], layers[index], 1);
   }
-  FillWeight();
+  FillWeight(init);
+}
+
+MatrixNetwork::MatrixNetwork(const LayerMatrices &layers) {
+  GetTopology(layers);
+  SetLayerMatrices(layers);
 }
 
 Matrix<float> MatrixNetwork::ForwardFeed(const Matrix<float> &sensor) {
-  return GetFullWay(sensor).back();
+  S21_TRACE_SCOPE("MatrixNetwork::ForwardFeed");
+  S21_PROFILE_SCOPE(Forward);
+  // Результат создается до шага, чтобы лежать в куче и не держать арену
+  Matrix<float> output(layers_.back().biases.GetRows(), 1);
+  MatrixArena::Step step;
+  output = FeedFrom(Sigmoid(SparseFeed(layers_.front(), sensor,
+                                       GetActiveSensors(sensor))),
+                    1);
+  return output;
 }
 
 void MatrixNetwork::Learn(const Matrix<float> &sensor, std::size_t answer,
                           const float learning_rate) {
-  auto way = GetFullWay(sensor);
-  BackPropagation(way, answer, learning_rate);
+  S21_TRACE_SCOPE("MatrixNetwork::Learn");
+  MatrixArena::Step step;
+  const auto active = GetActiveSensors(sensor);
+  auto way = GetFullWay(sensor, active);
+  BackPropagation(way, active, answer, learning_rate);
 }
 
-std::pair<std::size_t, std::size_t> MatrixNetwork::LoadWeights(
-    std::string path) {
-  std::ifstream file{path};
-  std::size_t size = 0;
-  file >> size;
-  if (size < 3 || size > 6) {
-    throw std::invalid_argument("The network size must be between 2 and 5.");
-  }
-  std::vector<Layer> layers;
-  layers.resize(size);
-  for (auto &[weights, bias] : layers) {
-    file >> weights >> bias;
-  }
-  file.close();
-  if (!file.bad()) {
-    layers_ = std::move(layers);
-  }
-  return {layers_.size() - 1, layers_[0].biases.GetRows()};
+std::vector<std::size_t> MatrixNetwork::LoadWeights(std::string path) {
+  S21_TRACE_SCOPE("MatrixNetwork::LoadWeights");
+  S21_PROFILE_SCOPE(Serialize);
+  const auto layers = ReadLayerMatrices(path);
+  SetLayerMatrices(layers);
+  return GetTopology(layers);
 }
 
 void MatrixNetwork::SaveWeights(std::string path) const {
+  S21_TRACE_SCOPE("MatrixNetwork::SaveWeights");
+  S21_PROFILE_SCOPE(Serialize);
   std::ofstream file{path};
   file << layers_.size() << '\n';
   for (auto &[weights, bias] : layers_) {
@@ -58,61 +65,181 @@ void MatrixNetwork::SaveWeights(std::string path) const {
   file.close();
 }
 
+std::unique_ptr<BaseNetwork> MatrixNetwork::Clone() const {
+  return std::make_unique<MatrixNetwork>(*this);
+}
+
+bool MatrixNetwork::CopyWeightsFrom(const BaseNetwork &other) {
+  const auto *network = dynamic_cast<const MatrixNetwork *>(&other);
+  if (!network || network->layers_.size() != layers_.size()) {
+    return false;
+  }
+  for (std::size_t index = 0; index < layers_.size(); ++index) {
+    const auto &source = network->layers_[index].weights;
+    if (source.GetRows() != layers_[index].weights.GetRows() ||
+        source.GetColumns() != layers_[index].weights.GetColumns()) {
+      return false;
+    }
+  }
+  for (std::size_t index = 0; index < layers_.size(); ++index) {
+    layers_[index].weights = network->layers_[index].weights;
+    layers_[index].biases = network->layers_[index].biases;
+  }
+  return true;
+}
+
+MatrixNetwork::LayerMatrices MatrixNetwork::GetLayerMatrices() const {
+  LayerMatrices layers;
+  layers.reserve(layers_.size());
+  for (const auto &[weights, biases] : layers_) {
+    layers.emplace_back(weights, biases);
+  }
+  return layers;
+}
+
+void MatrixNetwork::SetLayerMatrices(const LayerMatrices &layers) {
+  std::vector<Layer> new_layers;
+  new_layers.reserve(layers.size());
+  for (const auto &[weights, biases] : layers) {
+    auto &layer = new_layers.emplace_back();
+    layer.weights = weights;
+    layer.biases = biases;
+  }
+  layers_ = std::move(new_layers);
+}
+
+Matrix<float> MatrixNetwork::GetFirstLayerSum(const Matrix<float> &sensor) {
+  return SparseFeed(layers_.front(), sensor, GetActiveSensors(sensor));
+}
+
+void MatrixNetwork::AddFirstLayerDelta(Matrix<float> &sum, std::size_t sensor,
+                                       const float delta) const {
+  const auto &weights = layers_.front().weights;
+  for (std::size_t row = 0; row < sum.GetRows(); ++row) {
+    sum(row, 0) += weights(row, sensor) * delta;
+  }
+}
+
+Matrix<float> MatrixNetwork::ForwardFeedFromFirstLayer(
+    const Matrix<float> &sum) {
+  S21_PROFILE_SCOPE(Forward);
+  // Результат создается до шага, чтобы лежать в куче и не держать арену
+  Matrix<float> output(layers_.back().biases.GetRows(), 1);
+  MatrixArena::Step step;
+  output = FeedFrom(Sigmoid(sum), 1);
+  return output;
+}
+
+Matrix<float> MatrixNetwork::FeedFrom(Matrix<float> layer,
+                                      const std::size_t first) const {
+  Matrix<float> next;
+  for (std::size_t index = first; index < layers_.size(); ++index) {
+    auto &[weights, bias] = layers_[index];
+    next = Sigmoid(weights * layer + bias);
+    layer.Swap(next);
+  }
+  return layer;
+}
+
 std::vector<Matrix<float>> MatrixNetwork::GetFullWay(
     const Matrix<float> &sensor) const {
-  std::vector<Matrix<float>> way{sensor};
-  for (auto &[weights, bias] : layers_) {
-    way.push_back(Sigmoid(weights * way.back() + bias));
+  return GetFullWay(sensor, GetActiveSensors(sensor));
+}
+
+std::vector<Matrix<float>> MatrixNetwork::GetFullWay(
+    const Matrix<float> &sensor,
+    const std::vector<std::size_t> &active) const {
+  S21_PROFILE_SCOPE(Forward);
+  std::vector<Matrix<float>> way;
+  way.reserve(layers_.size() + 1);
+  way.push_back(sensor);
+  way.emplace_back(Sigmoid(SparseFeed(layers_.front(), sensor, active)));
+  for (std::size_t index = 1; index < layers_.size(); ++index) {
+    auto &[weights, bias] = layers_[index];
+    way.emplace_back(Sigmoid(weights * way.back() + bias));
   }
   return way;
 }
 
-void MatrixNetwork::FillWeight() {
-  std::random_device rd;
-  std::mt19937 mt(rd());
-  std::uniform_real_distribution<float> dist(-1.0, 1.0);
-  for (auto &[weight, bias] : layers_) {
-    for (std::size_t i = 0; i < weight.GetRows(); ++i) {
-      for (std::size_t j = 0; j < weight.GetColumns(); ++j) {
-        weight(i, j) = dist(mt);
-      }
-      bias(i, 0) = 1.f;
+std::vector<std::size_t> MatrixNetwork::GetActiveSensors(
+    const Matrix<float> &sensor) {
+  std::vector<std::size_t> active;
+  active.reserve(sensor.GetRows());
+  for (std::size_t index = 0; index < sensor.GetRows(); ++index) {
+    if (sensor(index, 0) != 0.f) {
+      active.push_back(index);
     }
   }
+  return active;
 }
 
-Matrix<float> MatrixNetwork::Sigmoid(Matrix<float> matrix) {
-  for (std::size_t i = 0; i < matrix.GetRows(); ++i) {
-    for (std::size_t j = 0; j < matrix.GetColumns(); ++j) {
-      float &item = matrix(i, j);
-      item = 1.f / (1.f + std::exp(-item));
+Matrix<float> MatrixNetwork::SparseFeed(
+    const Layer &layer, const Matrix<float> &sensor,
+    const std::vector<std::size_t> &active) {
+  if (layer.weights.GetColumns() != sensor.GetRows()) {
+    throw std::invalid_argument(
+        "Wrong matrix, different Size first matrix "
+        "columns and second matrix rows");
+  }
+  Matrix<float> result(layer.biases);
+  for (std::size_t row = 0; row < result.GetRows(); ++row) {
+    const float *weights = &layer.weights(row, 0);
+    float sum = 0.f;
+    for (const std::size_t column : active) {
+      sum += weights[column] * sensor(column, 0);
+    }
+    result(row, 0) += sum;
+  }
+  return result;
+}
+
+void MatrixNetwork::FillWeight(const WeightInit &init) {
+  for (std::size_t layer = 0; layer < layers_.size(); ++layer) {
+    auto &[weight, bias] = layers_[layer];
+    FillWeights(&weight(0, 0), weight.GetRows(), weight.GetColumns(), layer,
+                init);
+    for (std::size_t i = 0; i < bias.GetRows(); ++i) {
+      bias(i, 0) = 1.f;
     }
   }
-  return matrix;
 }
 
 void MatrixNetwork::BackPropagation(const std::vector<Matrix<float>> &way,
+                                    const std::vector<std::size_t> &active,
                                     std::size_t answer,
                                     const float learning_rate) {
   if (answer > 25) {
     throw std::invalid_argument("Bad EMNIST: answer letter is out of index");
   }
-  std::vector<Matrix<float>> error(way);
-  mse = 0;
-  for (std::size_t i = 0; i < way.back().GetRows(); ++i) {
-    const float value = way.back()(i, 0);
-    const float isAnswer = (i == answer ? 1.f : 0.f);
-    error.back()(i, 0) = value * (1 - value) * (isAnswer - value);
-    mse += powf(isAnswer - value, 2);
-  }
-  for (std::size_t i = way.size() - 2; i > 0; --i) {
-    error[i] = layers_[i].weights.Transpose() * error[i + 1];
-    for (std::size_t j = 0; j < error[i].GetRows(); ++j) {
-      error[i](j, 0) *= way[i](j, 0) * (1 - way[i](j, 0));
+  std::vector<Matrix<float>> error(way.size());
+  {
+    S21_PROFILE_SCOPE(Backward);
+    error.back() = Matrix<float>(way.back().GetRows(), 1);
+    mse = 0;
+    for (std::size_t i = 0; i < way.back().GetRows(); ++i) {
+      const float value = way.back()(i, 0);
+      const float isAnswer = (i == answer ? 1.f : 0.f);
+      error.back()(i, 0) = value * (1 - value) * (isAnswer - value);
+      mse += powf(isAnswer - value, 2);
+    }
+    for (std::size_t i = way.size() - 2; i > 0; --i) {
+      error[i] = Hadamard(Transpose(layers_[i].weights) * error[i + 1],
+                          Apply(way[i], [](const float value) {
+                            return value * (1 - value);
+                          }));
     }
   }
+  S21_PROFILE_SCOPE(Update);
   float err;
-  for (std::size_t i = 0; i < way.size() - 1; ++i) {
+  for (std::size_t j = 0; j < way[1].GetRows(); ++j) {
+    err = error[1](j, 0) * learning_rate;
+    layers_[0].biases(j, 0) += err;
+    float *weights = &layers_[0].weights(j, 0);
+    for (const std::size_t k : active) {
+      weights[k] += way[0](k, 0) * err;
+    }
+  }
+  for (std::size_t i = 1; i < way.size() - 1; ++i) {
     for (std::size_t j = 0; j < way[i + 1].GetRows(); ++j) {
       err = error[i + 1](j, 0) * learning_rate;
       layers_[i].biases(j, 0) += err;
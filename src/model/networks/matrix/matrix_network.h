@@ -13,8 +13,15 @@ class MatrixNetwork final : public BaseNetwork {
    * @brief Конструктор с заданными слоями
    * @details Создает слои размером каждого значения вектора
    * @param layers Вектор размеров слоев
+   * @param init Параметры начальной инициализации весов
    */
-  explicit MatrixNetwork(const std::vector<std::size_t> &layers);
+  explicit MatrixNetwork(const std::vector<std::size_t> &layers,
+                 const WeightInit &init = {});
+  /**
+   * @brief Конструктор по матрицам весов и смещений
+   * @param layers Пары матриц весов и смещений каждого слоя
+   */
+  explicit MatrixNetwork(const LayerMatrices &layers);
   //! Дефолтный конструктор копирования
   MatrixNetwork(const MatrixNetwork &a) = default;
   //! Дефолтный конструктор переноса
@@ -42,14 +49,55 @@ class MatrixNetwork final : public BaseNetwork {
   /**
    * @brief Загрузить веса
    * @param path Путь до файла
-   * @return Пара (Количество скрытых слоев, Количество нейронов в скрытом слою)
+   * @return Размеры слоев от входного до выходного
    */
-  std::pair<std::size_t, std::size_t> LoadWeights(std::string path) override;
+  std::vector<std::size_t> LoadWeights(std::string path) override;
   /**
    * @brief Сохранить веса
    * @param path Путь до файла
    */
   void SaveWeights(std::string path) const override;
+  /**
+   * @brief Создать независимую копию перцептрона
+   * @return Указатель на копию
+   */
+  std::unique_ptr<BaseNetwork> Clone() const override;
+  /**
+   * @brief Скопировать веса матричного перцептрона тех же размеров
+   * @param other Перцептрон
+   * @return Скопированы ли веса
+   */
+  bool CopyWeightsFrom(const BaseNetwork &other) override;
+  /**
+   * @brief Выгрузить веса и смещения в матрицы
+   * @return Пары матриц весов и смещений каждого слоя
+   */
+  LayerMatrices GetLayerMatrices() const override;
+  /**
+   * @brief Загрузить веса и смещения из матриц
+   * @param layers Пары матриц весов и смещений каждого слоя
+   */
+  void SetLayerMatrices(const LayerMatrices &layers) override;
+  /**
+   * @brief Подсчитать суммы первого скрытого слоя
+   * @param sensors Входные сенсоры
+   * @return Значения нейронов первого скрытого слоя до активации
+   */
+  Matrix<float> GetFirstLayerSum(const Matrix<float> &sensors) override;
+  /**
+   * @brief Добавить изменение одного сенсора в суммы первого слоя
+   * @param sum Значения нейронов первого скрытого слоя до активации
+   * @param sensor Индекс измененного сенсора
+   * @param delta Изменение значения сенсора
+   */
+  void AddFirstLayerDelta(Matrix<float> &sum, std::size_t sensor,
+                          float delta) const override;
+  /**
+   * @brief Прогнать от сумм первого скрытого слоя
+   * @param sum Значения нейронов первого скрытого слоя до активации
+   * @return Результативная матрица прогона данных по весам перцептрона
+   */
+  Matrix<float> ForwardFeedFromFirstLayer(const Matrix<float> &sum) override;
 
  private:
   //! Слой перцептрона
@@ -84,21 +132,70 @@ class MatrixNetwork final : public BaseNetwork {
    * @return Вектор значений нейронов
    */
   std::vector<Matrix<float>> GetFullWay(const Matrix<float> &sensors) const;
-  //! Заполнить веса случайными значениями
-  void FillWeight();
   /**
-   * @brief Применить сигмоиду ко всем значениям матрицы
-   * @param matrix Исходная матрица
-   * @return Итоговая матрица после сигмоиды
+   * @brief Прогнать все значения по сети с известными ненулевыми сенсорами
+   * @param sensors Входные сенсоры
+   * @param active Индексы ненулевых входных сенсоров
+   * @return Вектор значений нейронов
+   */
+  std::vector<Matrix<float>> GetFullWay(
+      const Matrix<float> &sensors,
+      const std::vector<std::size_t> &active) const;
+  /**
+   * @brief Собрать индексы ненулевых входных сенсоров
+   * @details Символы EMNIST в основном состоят из нулевых пикселей,
+   * поэтому первый слой обрабатывает только активные сенсоры
+   * @param sensors Входные сенсоры
+   * @return Вектор индексов ненулевых сенсоров
+   */
+  static std::vector<std::size_t> GetActiveSensors(
+      const Matrix<float> &sensors);
+  /**
+   * @brief Прогнать разреженные сенсоры через слой (без сигмоиды)
+   * @param layer Слой перцептрона
+   * @param sensors Входные сенсоры
+   * @param active Индексы ненулевых входных сенсоров
+   * @return Матрица значений нейронов слоя до активации
+   */
+  static Matrix<float> SparseFeed(const Layer &layer,
+                                  const Matrix<float> &sensors,
+                                  const std::vector<std::size_t> &active);
+  /**
+   * @brief Заполнить веса начальными значениями
+   * @param init Параметры начальной инициализации весов
+   */
+  void FillWeight(const WeightInit &init);
+  /**
+   * @brief Прогнать значения слоя по оставшимся слоям сети
+   * @details Слои считаются в два буфера по очереди, поэтому скрытые слои
+   * одного размера не выделяют память
+   * @param layer Значения нейронов слоя first - 1
+   * @param first Индекс первого применяемого слоя
+   * @return Матрица значений выходного слоя
+   */
+  Matrix<float> FeedFrom(Matrix<float> layer, std::size_t first) const;
+  /**
+   * @brief Применить сигмоиду ко всем значениям выражения
+   * @details Возвращает ленивое выражение, которое вычисляется за один
+   * проход при присваивании матрице
+   * @param expression Исходное матричное выражение
+   * @return Выражение после сигмоиды
    */
-  static Matrix<float> Sigmoid(Matrix<float> matrix);
+  template <class E>
+  static auto Sigmoid(E &&expression) {
+    return Apply(std::forward<E>(expression), [](const float value) {
+      return 1.f / (1.f + std::exp(-value));
+    });
+  }
   /**
    * @brief Выполнить обратное распространение ошибок
    * @param way Вектор матриц значений нейронов
+   * @param active Индексы ненулевых входных сенсоров
    * @param answer Правильный выходной индекс
    * @param learning_rate Скорость обучения
    */
   void BackPropagation(const std::vector<Matrix<float>> &way,
+                       const std::vector<std::size_t> &active,
                        std::size_t answer, float learning_rate);
   //! Слои сети
   std::vector<Layer> layers_;
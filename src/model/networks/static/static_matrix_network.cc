@@ -0,0 +1,17 @@
+#include "static_matrix_network.h"
+
+namespace s21 {
+
+template class StaticMatrixNetwork<784, 64, 64, 26>;
+
+std::unique_ptr<BaseNetwork> MakeStaticMatrixNetwork(
+    const std::vector<std::size_t> &layers, const WeightInit &init) {
+  if (std::equal(layers.begin(), layers.end(),
+                 ShippedStaticMatrixNetwork::sizes.begin(),
+                 ShippedStaticMatrixNetwork::sizes.end())) {
+    return std::make_unique<ShippedStaticMatrixNetwork>(init);
+  }
+  return nullptr;
+}
+
+}  // namespace s21
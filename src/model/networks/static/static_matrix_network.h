@@ -0,0 +1,574 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../../profiler/tracer.h"
+#include "../base/base_network.h"
+
+namespace s21 {
+
+/**
+ * @brief Матричный перцептрон с размерами слоев, известными при компиляции
+ * @details Веса лежат прямо в объекте, циклы имеют постоянные границы и
+ * полностью разворачиваются компилятором. Веса первого слоя хранятся по
+ * столбцам, чтобы разреженные входные сенсоры читали подряд идущую память.
+ * Файлы весов те же, что у MatrixNetwork
+ * @tparam Sizes Размеры слоев от входного до выходного
+ */
+template <std::size_t... Sizes>
+class StaticMatrixNetwork final : public BaseNetwork {
+  static_assert(sizeof...(Sizes) >= 3,
+                "The network must have at least one hidden layer.");
+
+ public:
+  //! Количество слоев вместе с входным
+  static constexpr std::size_t count_layers = sizeof...(Sizes);
+  //! Размеры слоев
+  static constexpr std::array<std::size_t, count_layers> sizes{Sizes...};
+  /**
+   * @brief Конструктор с начальными весами
+   * @details Веса первого слоя совпадают с весами MatrixNetwork при тех же
+   * параметрах, несмотря на хранение по столбцам
+   * @param init Параметры начальной инициализации весов
+   */
+  explicit StaticMatrixNetwork(const WeightInit &init = {});
+  //! Дефолтный конструктор копирования
+  StaticMatrixNetwork(const StaticMatrixNetwork &) = default;
+  //! Дефолтный конструктор переноса
+  StaticMatrixNetwork(StaticMatrixNetwork &&) = default;
+  //! Дефолтный оператор копирования
+  StaticMatrixNetwork &operator=(const StaticMatrixNetwork &) = default;
+  //! Дефолтный оператор переноса
+  StaticMatrixNetwork &operator=(StaticMatrixNetwork &&) = default;
+  //! Переопределение дефолтного деструктора
+  ~StaticMatrixNetwork() override = default;
+  /**
+   * @brief Прогона входных сенсоров
+   * @param sensors Входные сенсоры
+   * @return Результативная матрица прогона данных по весам перцептрона
+   */
+  Matrix<float> ForwardFeed(const Matrix<float> &sensors) override;
+  /**
+   * @brief Обучение перцептрона
+   * @param sensors Входные сенсоры
+   * @param answer Правильный индекс
+   * @param learning_rate Скорость обучения
+   */
+  void Learn(const Matrix<float> &sensors, std::size_t answer,
+             float learning_rate) override;
+  /**
+   * @brief Загрузить веса из файла
+   * @details Размеры слоев в файле должны совпадать с размерами шаблона
+   * @param path Путь до файла
+   * @return Размеры слоев от входного до выходного
+   */
+  std::vector<std::size_t> LoadWeights(std::string path) override;
+  /**
+   * @brief Сохранить веса в файл
+   * @param path Путь до файла
+   */
+  void SaveWeights(std::string path) const override;
+  /**
+   * @brief Создать независимую копию перцептрона
+   * @return Указатель на копию
+   */
+  std::unique_ptr<BaseNetwork> Clone() const override;
+  /**
+   * @brief Скопировать веса статического перцептрона той же топологии
+   * @param other Перцептрон
+   * @return Скопированы ли веса
+   */
+  bool CopyWeightsFrom(const BaseNetwork &other) override;
+  /**
+   * @brief Выгрузить веса и смещения в матрицы
+   * @return Пары матриц весов и смещений каждого слоя
+   */
+  LayerMatrices GetLayerMatrices() const override;
+  /**
+   * @brief Загрузить веса и смещения из матриц
+   * @param layers Пары матриц весов и смещений каждого слоя
+   */
+  void SetLayerMatrices(const LayerMatrices &layers) override;
+  /**
+   * @brief Подсчитать суммы первого скрытого слоя
+   * @param sensors Входные сенсоры
+   * @return Значения нейронов первого скрытого слоя до активации
+   */
+  Matrix<float> GetFirstLayerSum(const Matrix<float> &sensors) override;
+  /**
+   * @brief Добавить изменение одного сенсора в суммы первого слоя
+   * @param sum Значения нейронов первого скрытого слоя до активации
+   * @param sensor Индекс измененного сенсора
+   * @param delta Изменение значения сенсора
+   */
+  void AddFirstLayerDelta(Matrix<float> &sum, std::size_t sensor,
+                          float delta) const override;
+  /**
+   * @brief Прогнать от сумм первого скрытого слоя
+   * @param sum Значения нейронов первого скрытого слоя до активации
+   * @return Результативная матрица прогона данных по весам перцептрона
+   */
+  Matrix<float> ForwardFeedFromFirstLayer(const Matrix<float> &sum) override;
+
+ private:
+  //! Количество слоев весов
+  static constexpr std::size_t count_weights = count_layers - 1;
+  //! Слой весов размером Rows на Cols
+  template <std::size_t Rows, std::size_t Cols>
+  struct Layer {
+    std::array<float, Rows * Cols> weights;  //!< Веса
+    std::array<float, Rows> biases;          //!< Смещения
+  };
+  //! Построить тип кортежа слоев
+  template <std::size_t... I>
+  static auto MakeLayers(std::index_sequence<I...>)
+      -> std::tuple<Layer<sizes[I + 1], sizes[I]>...>;
+  //! Кортеж слоев весов
+  using Layers =
+      decltype(MakeLayers(std::make_index_sequence<count_weights>{}));
+  //! Кортеж значений нейронов всех слоев
+  using Way = std::tuple<std::array<float, Sizes>...>;
+  /**
+   * @brief Получить индекс веса в массиве слоя I
+   * @details Первый слой хранится по столбцам, остальные по строкам
+   * @param row Строка веса
+   * @param col Столбец веса
+   */
+  template <std::size_t I>
+  static constexpr std::size_t Index(std::size_t row, std::size_t col) {
+    if constexpr (I == 0) {
+      return col * sizes[I + 1] + row;
+    } else {
+      return row * sizes[I] + col;
+    }
+  }
+  //! Функция активации
+  static float Sigmoid(float value) { return 1.f / (1.f + std::exp(-value)); }
+  //! Проверить размер входных сенсоров
+  static void CheckSensors(const Matrix<float> &sensors);
+  /**
+   * @brief Собрать индексы ненулевых входных сенсоров
+   * @param sensors Входные сенсоры
+   * @return Количество ненулевых сенсоров в active_
+   */
+  std::size_t CollectActive(const float *sensors);
+  /**
+   * @brief Посчитать суммы первого скрытого слоя по активным сенсорам
+   * @param sensors Входные сенсоры
+   * @param count_active Количество активных сенсоров
+   * @param sum Суммы до активации
+   */
+  void FirstLayerSum(const float *sensors, std::size_t count_active,
+                     std::array<float, sizes[1]> &sum) const;
+  //! Прогнать слой I весов
+  template <std::size_t I>
+  void Feed();
+  //! Прогнать слои весов начиная со второго
+  template <std::size_t... I>
+  void FeedHidden(std::index_sequence<I...>);
+  //! Посчитать ошибку слоя нейронов I по ошибке следующего
+  template <std::size_t I>
+  void Propagate();
+  //! Посчитать ошибки скрытых слоев от последнего к первому
+  template <std::size_t... I>
+  void PropagateHidden(std::index_sequence<I...>);
+  //! Обновить слой I весов
+  template <std::size_t I>
+  void Update(float learning_rate);
+  //! Обновить слои весов начиная со второго
+  template <std::size_t... I>
+  void UpdateHidden(float learning_rate, std::index_sequence<I...>);
+  //! Выгрузить слой I в матрицы
+  template <std::size_t I>
+  void ExportLayer(LayerMatrices &layers) const;
+  //! Выгрузить все слои в матрицы
+  template <std::size_t... I>
+  void ExportLayers(LayerMatrices &layers, std::index_sequence<I...>) const;
+  //! Загрузить слой I из матриц
+  template <std::size_t I>
+  void ImportLayer(const LayerMatrices &layers);
+  //! Загрузить все слои из матриц
+  template <std::size_t... I>
+  void ImportLayers(const LayerMatrices &layers, std::index_sequence<I...>);
+  //! Выходной слой в виде матрицы
+  Matrix<float> Output() const;
+  //! Слои весов
+  Layers layers_;
+  //! Значения нейронов последнего прогона
+  Way way_;
+  //! Ошибки нейронов последнего обучения
+  Way error_;
+  //! Индексы ненулевых сенсоров последнего прогона
+  std::array<std::size_t, sizes[0]> active_;
+};
+
+template <std::size_t... Sizes>
+StaticMatrixNetwork<Sizes...>::StaticMatrixNetwork(const WeightInit &init)
+    : layers_(), way_(), error_(), active_() {
+  std::size_t index = 0;
+  std::apply(
+      [&](auto &...layer) {
+        auto fill = [&](auto &current) {
+          const std::size_t rows = current.biases.size();
+          FillWeights(current.weights.data(), rows,
+                      current.weights.size() / rows, index, init, index == 0);
+          current.biases.fill(1.f);
+          ++index;
+        };
+        (fill(layer), ...);
+      },
+      layers_);
+}
+
+template <std::size_t... Sizes>
+Matrix<float> StaticMatrixNetwork<Sizes...>::ForwardFeed(
+    const Matrix<float> &sensors) {
+  S21_TRACE_SCOPE("StaticMatrixNetwork::ForwardFeed");
+  CheckSensors(sensors);
+  auto &first = std::get<1>(way_);
+  FirstLayerSum(&sensors(0, 0), CollectActive(&sensors(0, 0)), first);
+  for (auto &value : first) {
+    value = Sigmoid(value);
+  }
+  FeedHidden(std::make_index_sequence<count_weights - 1>{});
+  return Output();
+}
+
+template <std::size_t... Sizes>
+void StaticMatrixNetwork<Sizes...>::Learn(const Matrix<float> &sensors,
+                                          const std::size_t answer,
+                                          const float learning_rate) {
+  S21_TRACE_SCOPE("StaticMatrixNetwork::Learn");
+  if (answer > 25) {
+    throw std::invalid_argument("Bad EMNIST: answer letter is out of index");
+  }
+  CheckSensors(sensors);
+  const float *input = &sensors(0, 0);
+  const std::size_t count_active = CollectActive(input);
+  auto &first = std::get<1>(way_);
+  FirstLayerSum(input, count_active, first);
+  for (auto &value : first) {
+    value = Sigmoid(value);
+  }
+  FeedHidden(std::make_index_sequence<count_weights - 1>{});
+
+  const auto &output = std::get<count_weights>(way_);
+  auto &output_error = std::get<count_weights>(error_);
+  mse = 0;
+  for (std::size_t i = 0; i < output.size(); ++i) {
+    const float value = output[i];
+    const float is_answer = (i == answer ? 1.f : 0.f);
+    output_error[i] = value * (1 - value) * (is_answer - value);
+    mse += powf(is_answer - value, 2);
+  }
+  PropagateHidden(std::make_index_sequence<count_weights - 1>{});
+
+  constexpr std::size_t rows = sizes[1];
+  auto &[weights, biases] = std::get<0>(layers_);
+  const auto &first_error = std::get<1>(error_);
+  std::array<float, rows> err;
+  for (std::size_t j = 0; j < rows; ++j) {
+    err[j] = first_error[j] * learning_rate;
+    biases[j] += err[j];
+  }
+  for (std::size_t index = 0; index < count_active; ++index) {
+    const std::size_t k = active_[index];
+    float *column = &weights[k * rows];
+    for (std::size_t j = 0; j < rows; ++j) {
+      column[j] += input[k] * err[j];
+    }
+  }
+  UpdateHidden(learning_rate, std::make_index_sequence<count_weights - 1>{});
+}
+
+template <std::size_t... Sizes>
+std::vector<std::size_t> StaticMatrixNetwork<Sizes...>::LoadWeights(
+    std::string path) {
+  S21_TRACE_SCOPE("StaticMatrixNetwork::LoadWeights");
+  const auto layers = ReadLayerMatrices(path);
+  const auto topology = GetTopology(layers);
+  if (!std::equal(sizes.begin(), sizes.end(), topology.begin(),
+                  topology.end())) {
+    throw std::invalid_argument(
+        "The network size doesn't match the static topology.");
+  }
+  SetLayerMatrices(layers);
+  return {Sizes...};
+}
+
+template <std::size_t... Sizes>
+void StaticMatrixNetwork<Sizes...>::SaveWeights(std::string path) const {
+  S21_TRACE_SCOPE("StaticMatrixNetwork::SaveWeights");
+  std::ofstream file{path};
+  file << count_weights << '\n';
+  for (auto &[weights, bias] : GetLayerMatrices()) {
+    file << weights << bias;
+  }
+  file.close();
+}
+
+template <std::size_t... Sizes>
+std::unique_ptr<BaseNetwork> StaticMatrixNetwork<Sizes...>::Clone() const {
+  return std::make_unique<StaticMatrixNetwork>(*this);
+}
+
+template <std::size_t... Sizes>
+bool StaticMatrixNetwork<Sizes...>::CopyWeightsFrom(const BaseNetwork &other) {
+  const auto *network = dynamic_cast<const StaticMatrixNetwork *>(&other);
+  if (!network) {
+    return false;
+  }
+  layers_ = network->layers_;
+  return true;
+}
+
+template <std::size_t... Sizes>
+BaseNetwork::LayerMatrices StaticMatrixNetwork<Sizes...>::GetLayerMatrices()
+    const {
+  LayerMatrices layers(count_weights);
+  ExportLayers(layers, std::make_index_sequence<count_weights>{});
+  return layers;
+}
+
+template <std::size_t... Sizes>
+void StaticMatrixNetwork<Sizes...>::SetLayerMatrices(
+    const LayerMatrices &layers) {
+  if (layers.size() != count_weights) {
+    throw std::invalid_argument(
+        "The network size doesn't match the static topology.");
+  }
+  ImportLayers(layers, std::make_index_sequence<count_weights>{});
+}
+
+template <std::size_t... Sizes>
+Matrix<float> StaticMatrixNetwork<Sizes...>::GetFirstLayerSum(
+    const Matrix<float> &sensors) {
+  CheckSensors(sensors);
+  std::array<float, sizes[1]> sum;
+  FirstLayerSum(&sensors(0, 0), CollectActive(&sensors(0, 0)), sum);
+  Matrix<float> result(sizes[1], 1);
+  for (std::size_t row = 0; row < sizes[1]; ++row) {
+    result(row, 0) = sum[row];
+  }
+  return result;
+}
+
+template <std::size_t... Sizes>
+void StaticMatrixNetwork<Sizes...>::AddFirstLayerDelta(
+    Matrix<float> &sum, const std::size_t sensor, const float delta) const {
+  const float *column = &std::get<0>(layers_).weights[sensor * sizes[1]];
+  for (std::size_t row = 0; row < sizes[1]; ++row) {
+    sum(row, 0) += column[row] * delta;
+  }
+}
+
+template <std::size_t... Sizes>
+Matrix<float> StaticMatrixNetwork<Sizes...>::ForwardFeedFromFirstLayer(
+    const Matrix<float> &sum) {
+  if (sum.GetRows() != sizes[1]) {
+    throw std::invalid_argument("Wrong first layer size");
+  }
+  auto &first = std::get<1>(way_);
+  for (std::size_t row = 0; row < sizes[1]; ++row) {
+    first[row] = Sigmoid(sum(row, 0));
+  }
+  FeedHidden(std::make_index_sequence<count_weights - 1>{});
+  return Output();
+}
+
+template <std::size_t... Sizes>
+void StaticMatrixNetwork<Sizes...>::CheckSensors(
+    const Matrix<float> &sensors) {
+  if (sensors.GetRows() != sizes[0] || sensors.GetColumns() != 1) {
+    throw std::invalid_argument(
+        "Wrong matrix, different Size first matrix "
+        "columns and second matrix rows");
+  }
+}
+
+template <std::size_t... Sizes>
+std::size_t StaticMatrixNetwork<Sizes...>::CollectActive(
+    const float *sensors) {
+  std::size_t count_active = 0;
+  for (std::size_t index = 0; index < sizes[0]; ++index) {
+    if (sensors[index] != 0.f) {
+      active_[count_active++] = index;
+    }
+  }
+  return count_active;
+}
+
+template <std::size_t... Sizes>
+void StaticMatrixNetwork<Sizes...>::FirstLayerSum(
+    const float *sensors, const std::size_t count_active,
+    std::array<float, sizes[1]> &sum) const {
+  constexpr std::size_t rows = sizes[1];
+  const auto &[weights, biases] = std::get<0>(layers_);
+  std::array<float, rows> accumulator{};
+  for (std::size_t index = 0; index < count_active; ++index) {
+    const std::size_t column = active_[index];
+    const float *weight = &weights[column * rows];
+    const float value = sensors[column];
+    for (std::size_t row = 0; row < rows; ++row) {
+      accumulator[row] += weight[row] * value;
+    }
+  }
+  for (std::size_t row = 0; row < rows; ++row) {
+    sum[row] = biases[row] + accumulator[row];
+  }
+}
+
+template <std::size_t... Sizes>
+template <std::size_t I>
+void StaticMatrixNetwork<Sizes...>::Feed() {
+  constexpr std::size_t rows = sizes[I + 1], cols = sizes[I];
+  const auto &[weights, biases] = std::get<I>(layers_);
+  const auto &input = std::get<I>(way_);
+  auto &output = std::get<I + 1>(way_);
+  for (std::size_t row = 0; row < rows; ++row) {
+    const float *weight = &weights[row * cols];
+    float sum = 0.f;
+    for (std::size_t col = 0; col < cols; ++col) {
+      sum += weight[col] * input[col];
+    }
+    output[row] = Sigmoid(sum + biases[row]);
+  }
+}
+
+template <std::size_t... Sizes>
+template <std::size_t... I>
+void StaticMatrixNetwork<Sizes...>::FeedHidden(std::index_sequence<I...>) {
+  (Feed<I + 1>(), ...);
+}
+
+template <std::size_t... Sizes>
+template <std::size_t I>
+void StaticMatrixNetwork<Sizes...>::Propagate() {
+  constexpr std::size_t rows = sizes[I + 1], cols = sizes[I];
+  const auto &weights = std::get<I>(layers_).weights;
+  const auto &next_error = std::get<I + 1>(error_);
+  const auto &value = std::get<I>(way_);
+  auto &error = std::get<I>(error_);
+  error.fill(0.f);
+  for (std::size_t row = 0; row < rows; ++row) {
+    const float *weight = &weights[row * cols];
+    for (std::size_t col = 0; col < cols; ++col) {
+      error[col] += weight[col] * next_error[row];
+    }
+  }
+  for (std::size_t col = 0; col < cols; ++col) {
+    error[col] *= value[col] * (1 - value[col]);
+  }
+}
+
+template <std::size_t... Sizes>
+template <std::size_t... I>
+void StaticMatrixNetwork<Sizes...>::PropagateHidden(
+    std::index_sequence<I...>) {
+  (Propagate<sizeof...(I) - I>(), ...);
+}
+
+template <std::size_t... Sizes>
+template <std::size_t I>
+void StaticMatrixNetwork<Sizes...>::Update(const float learning_rate) {
+  constexpr std::size_t rows = sizes[I + 1], cols = sizes[I];
+  auto &[weights, biases] = std::get<I>(layers_);
+  const auto &error = std::get<I + 1>(error_);
+  const auto &input = std::get<I>(way_);
+  for (std::size_t row = 0; row < rows; ++row) {
+    const float err = error[row] * learning_rate;
+    biases[row] += err;
+    float *weight = &weights[row * cols];
+    for (std::size_t col = 0; col < cols; ++col) {
+      weight[col] += input[col] * err;
+    }
+  }
+}
+
+template <std::size_t... Sizes>
+template <std::size_t... I>
+void StaticMatrixNetwork<Sizes...>::UpdateHidden(const float learning_rate,
+                                                 std::index_sequence<I...>) {
+  (Update<I + 1>(learning_rate), ...);
+}
+
+template <std::size_t... Sizes>
+template <std::size_t I>
+void StaticMatrixNetwork<Sizes...>::ExportLayer(LayerMatrices &layers) const {
+  constexpr std::size_t rows = sizes[I + 1], cols = sizes[I];
+  const auto &[weights, biases] = std::get<I>(layers_);
+  auto &[weight_matrix, bias_matrix] = layers[I];
+  weight_matrix.Set(rows, cols);
+  bias_matrix.Set(rows, 1);
+  for (std::size_t row = 0; row < rows; ++row) {
+    for (std::size_t col = 0; col < cols; ++col) {
+      weight_matrix(row, col) = weights[Index<I>(row, col)];
+    }
+    bias_matrix(row, 0) = biases[row];
+  }
+}
+
+template <std::size_t... Sizes>
+template <std::size_t I>
+void StaticMatrixNetwork<Sizes...>::ImportLayer(const LayerMatrices &layers) {
+  constexpr std::size_t rows = sizes[I + 1], cols = sizes[I];
+  const auto &[weight_matrix, bias_matrix] = layers[I];
+  if (weight_matrix.GetRows() != rows || weight_matrix.GetColumns() != cols ||
+      bias_matrix.GetRows() != rows || bias_matrix.GetColumns() != 1) {
+    throw std::invalid_argument(
+        "The layer size doesn't match the static topology.");
+  }
+  auto &[weights, biases] = std::get<I>(layers_);
+  for (std::size_t row = 0; row < rows; ++row) {
+    for (std::size_t col = 0; col < cols; ++col) {
+      weights[Index<I>(row, col)] = weight_matrix(row, col);
+    }
+    biases[row] = bias_matrix(row, 0);
+  }
+}
+
+template <std::size_t... Sizes>
+template <std::size_t... I>
+void StaticMatrixNetwork<Sizes...>::ExportLayers(
+    LayerMatrices &layers, std::index_sequence<I...>) const {
+  (ExportLayer<I>(layers), ...);
+}
+
+template <std::size_t... Sizes>
+template <std::size_t... I>
+void StaticMatrixNetwork<Sizes...>::ImportLayers(const LayerMatrices &layers,
+                                                 std::index_sequence<I...>) {
+  (ImportLayer<I>(layers), ...);
+}
+
+template <std::size_t... Sizes>
+Matrix<float> StaticMatrixNetwork<Sizes...>::Output() const {
+  const auto &output = std::get<count_weights>(way_);
+  Matrix<float> result(output.size(), 1);
+  for (std::size_t row = 0; row < output.size(); ++row) {
+    result(row, 0) = output[row];
+  }
+  return result;
+}
+
+//! Топология, поставляемая в продакшен
+using ShippedStaticMatrixNetwork = StaticMatrixNetwork<784, 64, 64, 26>;
+
+extern template class StaticMatrixNetwork<784, 64, 64, 26>;
+
+/**
+ * @brief Создать статический перцептрон для поставляемой топологии
+ * @param layers Размеры слоев
+ * @param init Параметры начальной инициализации весов
+ * @return Указатель на перцептрон или nullptr, если топология не поставляется
+ */
+std::unique_ptr<BaseNetwork> MakeStaticMatrixNetwork(
+    const std::vector<std::size_t> &layers, const WeightInit &init = {});
+
+}  // namespace s21
@@ -0,0 +1,138 @@
+#include "image_preprocessor.h"
+
+namespace s21 {
+
+ImagePreprocessor::ImagePreprocessor() : ImagePreprocessor(0.f) {}
+
+ImagePreprocessor::ImagePreprocessor(const float blur_radius,
+                                     const bool invert)
+    : columns_(),
+      rows_(),
+      width_(0),
+      height_(0),
+      invert_(invert),
+      kernel_radius_(0),
+      kernel_(),
+      cells_(),
+      buffer_(),
+      sensors_(count_sensors, 1) {
+  const float sigma = std::max(blur_radius, 0.f) / 3.f;
+  if (sigma > 0.f) {
+    kernel_radius_ = std::min(static_cast<std::size_t>(std::ceil(3.f * sigma)),
+                              side - 1);
+  }
+  float sum = 0.f;
+  for (std::size_t index = 0; index <= kernel_radius_; ++index) {
+    const auto offset = static_cast<float>(index);
+    kernel_[index] =
+        sigma > 0.f ? std::exp(-offset * offset / (2.f * sigma * sigma)) : 1.f;
+    sum += index == 0 ? kernel_[index] : 2.f * kernel_[index];
+  }
+  for (std::size_t index = 0; index <= kernel_radius_; ++index) {
+    kernel_[index] /= sum;
+  }
+}
+
+const Matrix<float> &ImagePreprocessor::Process(const std::uint8_t *pixels,
+                                                const std::size_t width,
+                                                const std::size_t height,
+                                                const std::size_t stride) {
+  Process(pixels, width, height, stride, sensors_);
+  return sensors_;
+}
+
+void ImagePreprocessor::Process(const std::uint8_t *pixels,
+                                const std::size_t width,
+                                const std::size_t height,
+                                const std::size_t stride,
+                                Matrix<float> &sensors) {
+  if (pixels == nullptr || width == 0 || height == 0 || stride < width) {
+    throw std::invalid_argument("Bad image: empty buffer or wrong stride");
+  }
+  if (sensors.GetRows() != count_sensors || sensors.GetColumns() != 1) {
+    throw std::invalid_argument("Bad image: sensors must be 784x1");
+  }
+  if (width != width_ || height != height_) {
+    FillBounds(width, columns_);
+    FillBounds(height, rows_);
+    width_ = width, height_ = height;
+  }
+  Downscale(pixels, stride);
+  if (kernel_radius_ > 0) {
+    Blur();
+  }
+  float *output = &sensors(0, 0);
+  for (std::size_t x = 0; x < side; ++x) {
+    for (std::size_t y = 0; y < side; ++y) {
+      output[x * side + y] =
+          std::clamp(cells_[y * side + x] / 255.f, 0.f, 1.f);
+    }
+  }
+}
+
+void ImagePreprocessor::FillBounds(const std::size_t size, Bounds &bounds) {
+  for (std::size_t index = 0; index <= side; ++index) {
+    bounds[index] = index * size / side;
+  }
+}
+
+void ImagePreprocessor::Downscale(const std::uint8_t *pixels,
+                                  const std::size_t stride) {
+  for (std::size_t y = 0; y < side; ++y) {
+    const std::size_t y_end = std::max(rows_[y + 1], rows_[y] + 1);
+    for (std::size_t x = 0; x < side; ++x) {
+      const std::size_t x_end = std::max(columns_[x + 1], columns_[x] + 1);
+      std::uint32_t sum = 0;
+      for (std::size_t row = rows_[y]; row < y_end; ++row) {
+        const std::uint8_t *line = pixels + row * stride;
+        for (std::size_t column = columns_[x]; column < x_end; ++column) {
+          sum += line[column];
+        }
+      }
+      const auto count =
+          static_cast<float>((y_end - rows_[y]) * (x_end - columns_[x]));
+      const float mean = static_cast<float>(sum) / count;
+      cells_[y * side + x] = invert_ ? 255.f - mean : mean;
+    }
+  }
+}
+
+void ImagePreprocessor::Blur() {
+  const auto radius = static_cast<std::ptrdiff_t>(kernel_radius_);
+  const auto size = static_cast<std::ptrdiff_t>(side);
+  for (std::ptrdiff_t y = 0; y < size; ++y) {
+    const float *line = &cells_[y * size];
+    for (std::ptrdiff_t x = 0; x < size; ++x) {
+      float sum = kernel_[0] * line[x];
+      for (std::ptrdiff_t offset = 1; offset <= radius; ++offset) {
+        const float left = x - offset >= 0 ? line[x - offset] : 0.f;
+        const float right = x + offset < size ? line[x + offset] : 0.f;
+        sum += kernel_[offset] * (left + right);
+      }
+      buffer_[y * size + x] = sum;
+    }
+  }
+  for (std::ptrdiff_t y = 0; y < size; ++y) {
+    float *line = &cells_[y * size];
+    for (std::ptrdiff_t x = 0; x < size; ++x) {
+      line[x] = kernel_[0] * buffer_[y * size + x];
+    }
+    for (std::ptrdiff_t offset = 1; offset <= radius; ++offset) {
+      const float weight = kernel_[offset];
+      if (y - offset >= 0) {
+        const float *up = &buffer_[(y - offset) * size];
+        for (std::ptrdiff_t x = 0; x < size; ++x) {
+          line[x] += weight * up[x];
+        }
+      }
+      if (y + offset < size) {
+        const float *down = &buffer_[(y + offset) * size];
+        for (std::ptrdiff_t x = 0; x < size; ++x) {
+          line[x] += weight * down[x];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace s21
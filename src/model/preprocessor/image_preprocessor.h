@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "../../third-party/matrix.h"
+
+namespace s21 {
+
+//! Подготовка изображения символа к подаче на вход перцептрона
+class ImagePreprocessor {
+ public:
+  //! Сторона изображения EMNIST
+  static constexpr std::size_t side = 28;
+  //! Количество входных сенсоров
+  static constexpr std::size_t count_sensors = side * side;
+  //! Конструктор без размытия
+  ImagePreprocessor();
+  /**
+   * @brief Конструктор с заданием размытия
+   * @param blur_radius Радиус размытия в пикселях 28x28 (0 - без размытия)
+   * @param invert Темные пиксели исходника считаются чернилами
+   */
+  explicit ImagePreprocessor(float blur_radius, bool invert = true);
+  //! Дефолтный конструктор копирования
+  ImagePreprocessor(const ImagePreprocessor &) = default;
+  //! Дефолтный конструктор переноса
+  ImagePreprocessor(ImagePreprocessor &&) = default;
+  //! Дефолтный оператор копирования
+  ImagePreprocessor &operator=(const ImagePreprocessor &) = default;
+  //! Дефолтный оператор переноса
+  ImagePreprocessor &operator=(ImagePreprocessor &&) = default;
+  //! Дефолтный деструктор
+  ~ImagePreprocessor() = default;
+  /**
+   * @brief Обработать изображение во внутренний буфер
+   * @details Уменьшает изображение до 28x28 усреднением, размывает,
+   * транспонирует в ориентацию EMNIST и нормирует в [0, 1].
+   * Буфер переиспользуется между вызовами
+   * @param pixels Пиксели в оттенках серого, по байту на пиксель
+   * @param width Ширина изображения
+   * @param height Высота изображения
+   * @param stride Количество байт в строке изображения
+   * @return Ссылка на внутренний буфер сенсоров 784x1
+   */
+  const Matrix<float> &Process(const std::uint8_t *pixels, std::size_t width,
+                               std::size_t height, std::size_t stride);
+  /**
+   * @brief Обработать изображение в заданный буфер
+   * @param pixels Пиксели в оттенках серого, по байту на пиксель
+   * @param width Ширина изображения
+   * @param height Высота изображения
+   * @param stride Количество байт в строке изображения
+   * @param sensors Буфер сенсоров 784x1
+   */
+  void Process(const std::uint8_t *pixels, std::size_t width,
+               std::size_t height, std::size_t stride,
+               Matrix<float> &sensors);
+
+ private:
+  //! Границы усреднения исходных пикселей для каждой клетки
+  typedef std::array<std::size_t, side + 1> Bounds;
+  //! Изображение 28x28
+  typedef std::array<float, count_sensors> Cells;
+  /**
+   * @brief Посчитать границы усреднения по одной оси
+   * @param size Размер исходного изображения по оси
+   * @param bounds Границы клеток
+   */
+  static void FillBounds(std::size_t size, Bounds &bounds);
+  /**
+   * @brief Уменьшить изображение до 28x28
+   * @param pixels Пиксели в оттенках серого
+   * @param stride Количество байт в строке изображения
+   */
+  void Downscale(const std::uint8_t *pixels, std::size_t stride);
+  //! Размыть изображение 28x28 разделимым гауссовым фильтром
+  void Blur();
+  //! Границы усреднения по столбцам
+  Bounds columns_;
+  //! Границы усреднения по строкам
+  Bounds rows_;
+  //! Ширина последнего изображения
+  std::size_t width_;
+  //! Высота последнего изображения
+  std::size_t height_;
+  //! Инвертировать ли яркость
+  bool invert_;
+  //! Радиус ядра размытия
+  std::size_t kernel_radius_;
+  //! Половина ядра размытия, начиная с центра
+  std::array<float, side> kernel_;
+  //! Уменьшенное изображение
+  Cells cells_;
+  //! Промежуточный буфер размытия
+  Cells buffer_;
+  //! Внутренний буфер сенсоров
+  Matrix<float> sensors_;
+};
+
+}  // namespace s21
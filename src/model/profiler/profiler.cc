@@ -0,0 +1,147 @@
+#include "profiler.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../../third-party/matrix_memory.h"
+
+namespace s21 {
+
+namespace {
+
+struct Counters {
+  std::array<std::atomic<std::uint64_t>, Profiler::count_phases> nanoseconds{};
+  std::array<std::atomic<std::uint64_t>, Profiler::count_phases> calls{};
+  std::atomic<std::uint64_t> samples{0};
+};
+
+// Сумма счетчиков завершившихся потоков
+struct Totals {
+  std::array<std::uint64_t, Profiler::count_phases> nanoseconds{};
+  std::array<std::uint64_t, Profiler::count_phases> calls{};
+  std::uint64_t samples = 0;
+};
+
+std::mutex registry_mutex;
+// Счетчики всех выделенных потокам слотов, свободные обнулены
+std::vector<std::shared_ptr<Counters>> registry;
+// Слоты завершившихся потоков, готовые к выдаче новым потокам
+std::vector<std::shared_ptr<Counters>> free_counters;
+Totals finished;
+
+std::shared_ptr<Counters> Acquire() {
+  std::lock_guard lock(registry_mutex);
+  if (!free_counters.empty()) {
+    auto counters = std::move(free_counters.back());
+    free_counters.pop_back();
+    return counters;
+  }
+  registry.push_back(std::make_shared<Counters>());
+  return registry.back();
+}
+
+// Вызывается потоком-владельцем, поэтому слот уже никто не пополняет
+void Retire(const std::shared_ptr<Counters> &counters) {
+  std::lock_guard lock(registry_mutex);
+  for (std::size_t phase = 0; phase < Profiler::count_phases; ++phase) {
+    finished.nanoseconds[phase] +=
+        counters->nanoseconds[phase].exchange(0, std::memory_order_relaxed);
+    finished.calls[phase] +=
+        counters->calls[phase].exchange(0, std::memory_order_relaxed);
+  }
+  finished.samples += counters->samples.exchange(0, std::memory_order_relaxed);
+  free_counters.push_back(counters);
+}
+
+// Слот берется при первом замере потока, а при его завершении счетчики
+// прибавляются к finished и слот отдается следующему потоку
+struct Owner {
+  Owner() : counters(Acquire()) {}
+  Owner(const Owner &) = delete;
+  Owner &operator=(const Owner &) = delete;
+  ~Owner() { Retire(counters); }
+  const std::shared_ptr<Counters> counters;
+};
+
+Counters &Local() {
+  thread_local const Owner owner;
+  return *owner.counters;
+}
+
+}  // namespace
+
+void Profiler::Add(const Phase phase,
+                   const std::chrono::nanoseconds duration) noexcept {
+  auto &counters = Local();
+  const auto index = static_cast<std::size_t>(phase);
+  counters.nanoseconds[index].fetch_add(
+      static_cast<std::uint64_t>(duration.count()), std::memory_order_relaxed);
+  counters.calls[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::AddSamples(const std::uint64_t count) noexcept {
+  Local().samples.fetch_add(count, std::memory_order_relaxed);
+}
+
+Profiler::Stats Profiler::GetStats() {
+  Stats stats{};
+  std::array<std::uint64_t, count_phases> nanoseconds{};
+  {
+    std::lock_guard lock(registry_mutex);
+    nanoseconds = finished.nanoseconds;
+    for (std::size_t phase = 0; phase < count_phases; ++phase) {
+      stats.phases[phase].calls = finished.calls[phase];
+    }
+    stats.samples = finished.samples;
+    for (const auto &counters : registry) {
+      for (std::size_t phase = 0; phase < count_phases; ++phase) {
+        nanoseconds[phase] +=
+            counters->nanoseconds[phase].load(std::memory_order_relaxed);
+        stats.phases[phase].calls +=
+            counters->calls[phase].load(std::memory_order_relaxed);
+      }
+      stats.samples += counters->samples.load(std::memory_order_relaxed);
+    }
+  }
+  for (std::size_t phase = 0; phase < count_phases; ++phase) {
+    stats.phases[phase].seconds =
+        static_cast<double>(nanoseconds[phase]) * 1e-9;
+  }
+  const double train_seconds =
+      stats.phases[static_cast<std::size_t>(Phase::Train)].seconds;
+  stats.samples_per_sec =
+      train_seconds > 0. ? static_cast<double>(stats.samples) / train_seconds
+                         : 0.;
+  const auto memory = MatrixHeap::Instance().GetStats();
+  stats.allocations = memory.allocations;
+  stats.peak_bytes = memory.peak_bytes;
+  stats.skipped_resets = MatrixArena::GetSkippedResets();
+  return stats;
+}
+
+void Profiler::Reset() {
+  std::lock_guard lock(registry_mutex);
+  finished = Totals{};
+  for (const auto &counters : registry) {
+    for (std::size_t phase = 0; phase < count_phases; ++phase) {
+      counters->nanoseconds[phase].store(0, std::memory_order_relaxed);
+      counters->calls[phase].store(0, std::memory_order_relaxed);
+    }
+    counters->samples.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::size_t Profiler::GetCounterCount() {
+  std::lock_guard lock(registry_mutex);
+  return registry.size();
+}
+
+const char *Profiler::GetPhaseName(const Phase phase) noexcept {
+  static constexpr std::array<const char *, count_phases> names{
+      "parse", "forward", "backward", "update", "serialize", "train"};
+  const auto index = static_cast<std::size_t>(phase);
+  return index < count_phases ? names[index] : "unknown";
+}
+
+}  // namespace s21
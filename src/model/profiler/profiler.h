@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace s21 {
+
+/**
+ * @brief Таймеры горячих участков обучения и распознавания
+ * @details Время фаз копится в счетчиках каждого потока без блокировок и
+ * суммируется при запросе статистики. Счетчики завершившегося потока
+ * прибавляются к общей сумме, а их слот отдается новым потокам, поэтому
+ * слотов не больше, чем потоков одновременно. Без опции сборки S21_PROFILE
+ * макросы S21_PROFILE_SCOPE и S21_PROFILE_SAMPLES ничего не делают
+ */
+class Profiler {
+ public:
+  //! Фазы
+  enum class Phase : std::size_t {
+    Parse,      //!< Разбор выборки
+    Forward,    //!< Прямой прогон
+    Backward,   //!< Обратное распространение ошибки
+    Update,     //!< Обновление весов
+    Serialize,  //!< Сохранение и загрузка весов
+    Train,      //!< Эпоха обучения целиком
+    Count       //!< Количество фаз
+  };
+  //! Количество фаз
+  static constexpr std::size_t count_phases =
+      static_cast<std::size_t>(Phase::Count);
+  //! Накопленное время фазы
+  struct PhaseStats {
+    double seconds;       //!< Суммарное время по всем потокам
+    std::uint64_t calls;  //!< Количество замеров
+  };
+  //! Снимок статистики
+  struct Stats {
+    std::array<PhaseStats, count_phases> phases;  //!< Фазы
+    std::uint64_t samples;   //!< Обучено примеров
+    double samples_per_sec;  //!< Примеров в секунду эпохи на поток
+    std::size_t allocations;  //!< Выделений памяти матриц у системной кучи
+    std::size_t peak_bytes;   //!< Пик памяти матриц в байтах
+    std::size_t skipped_resets;  //!< Отложенных сбросов арен матриц
+  };
+  //! Собраны ли таймеры
+  static constexpr bool enabled =
+#ifdef S21_PROFILE
+      true;
+#else
+      false;
+#endif
+  //! Замер фазы на время жизни объекта
+  class Scope {
+   public:
+    /**
+     * @brief Начать замер
+     * @param phase Фаза
+     */
+    explicit Scope(Phase phase) noexcept
+        : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+    //! Закончить замер
+    ~Scope() { Add(phase_, std::chrono::steady_clock::now() - start_); }
+
+   private:
+    Phase phase_;
+    std::chrono::steady_clock::time_point start_;
+  };
+  /**
+   * @brief Добавить время фазы
+   * @param phase Фаза
+   * @param duration Длительность
+   */
+  static void Add(Phase phase, std::chrono::nanoseconds duration) noexcept;
+  /**
+   * @brief Добавить обученные примеры
+   * @param count Количество примеров
+   */
+  static void AddSamples(std::uint64_t count) noexcept;
+  //! Получить статистику всех потоков
+  static Stats GetStats();
+  //! Обнулить таймеры и счетчики
+  static void Reset();
+  //! Получить количество выделенных слотов счетчиков потоков
+  static std::size_t GetCounterCount();
+  //! Получить название фазы
+  static const char *GetPhaseName(Phase phase) noexcept;
+};
+
+}  // namespace s21
+
+#ifdef S21_PROFILE
+#define S21_PROFILE_CONCAT_IMPL(left, right) left##right
+#define S21_PROFILE_CONCAT(left, right) S21_PROFILE_CONCAT_IMPL(left, right)
+//! Замерить фазу до конца текущего блока
+#define S21_PROFILE_SCOPE(phase)                                     \
+  const ::s21::Profiler::Scope S21_PROFILE_CONCAT(s21_profile_scope_, \
+                                                  __LINE__)(         \
+      ::s21::Profiler::Phase::phase)
+//! Добавить обученные примеры
+#define S21_PROFILE_SAMPLES(count) ::s21::Profiler::AddSamples(count)
+#else
+#define S21_PROFILE_SCOPE(phase) static_cast<void>(0)
+#define S21_PROFILE_SAMPLES(count) static_cast<void>(0)
+#endif
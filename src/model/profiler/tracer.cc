@@ -0,0 +1,194 @@
+#include "tracer.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace s21 {
+
+namespace {
+
+struct Slot {
+  std::atomic<const char *> name{nullptr};
+  std::atomic<std::int64_t> begin{0}, duration{0};
+};
+
+// Буфер пишет только его поток, читатели видят отрезки до head. Номер
+// потока меняется только под registry_mutex при выдаче буфера потоку
+struct Ring {
+  std::uint32_t thread = 0;
+  std::atomic<std::uint64_t> head{0};
+  std::array<Slot, Tracer::ring_size> slots;
+};
+
+std::mutex registry_mutex;
+// Буферы живых и завершенных потоков, отрезки которых еще читаются
+std::vector<std::shared_ptr<Ring>> registry;
+// Буферы завершенных потоков из registry от старых к новым
+std::deque<std::shared_ptr<Ring>> retired;
+// Буферы, готовые к выдаче новым потокам
+std::vector<std::shared_ptr<Ring>> free_rings;
+// Отрезки буферов завершенных потоков, отданных другим потокам до записи
+std::uint64_t dropped_retired = 0;
+std::uint32_t next_thread = 0;
+std::atomic<std::int64_t> origin{0};
+
+void Unregister(const std::shared_ptr<Ring> &ring) {
+  registry.erase(std::find(registry.begin(), registry.end(), ring));
+}
+
+std::shared_ptr<Ring> Acquire() {
+  std::lock_guard lock(registry_mutex);
+  std::shared_ptr<Ring> ring;
+  if (!free_rings.empty()) {
+    ring = std::move(free_rings.back());
+    free_rings.pop_back();
+  } else if (retired.size() >= Tracer::retired_limit) {
+    ring = std::move(retired.front());
+    retired.pop_front();
+    Unregister(ring);
+    dropped_retired += ring->head.load(std::memory_order_relaxed);
+  } else {
+    ring = std::make_shared<Ring>();
+  }
+  ring->thread = next_thread++;
+  ring->head.store(0, std::memory_order_relaxed);
+  registry.push_back(ring);
+  return ring;
+}
+
+void Retire(const std::shared_ptr<Ring> &ring) {
+  std::lock_guard lock(registry_mutex);
+  if (ring->head.load(std::memory_order_relaxed) == 0) {
+    Unregister(ring);
+    free_rings.push_back(ring);
+  } else {
+    retired.push_back(ring);
+  }
+}
+
+// Буфер берется при первом отрезке потока и возвращается при его
+// завершении: пустой сразу, с отрезками - на следующем Start
+struct Owner {
+  Owner() : ring(Acquire()) {}
+  Owner(const Owner &) = delete;
+  Owner &operator=(const Owner &) = delete;
+  ~Owner() { Retire(ring); }
+  const std::shared_ptr<Ring> ring;
+};
+
+Ring &Local() {
+  thread_local const Owner owner;
+  return *owner.ring;
+}
+
+void WriteEscaped(std::ostream &file, const char *text) {
+  for (; *text; ++text) {
+    if (*text == '"' || *text == '\\') {
+      file << '\\';
+    }
+    file << *text;
+  }
+}
+
+}  // namespace
+
+void Tracer::Start() {
+  {
+    std::lock_guard lock(registry_mutex);
+    for (auto &ring : retired) {
+      Unregister(ring);
+      free_rings.push_back(std::move(ring));
+    }
+    retired.clear();
+    dropped_retired = 0;
+    for (const auto &ring : registry) {
+      ring->head.store(0, std::memory_order_release);
+    }
+  }
+  origin.store(Now(), std::memory_order_relaxed);
+  enabled_.store(true, std::memory_order_release);
+}
+
+void Tracer::Stop() noexcept {
+  enabled_.store(false, std::memory_order_release);
+}
+
+void Tracer::Record(const char *name, const std::int64_t begin,
+                    const std::int64_t end) noexcept {
+  auto &ring = Local();
+  const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+  auto &slot = ring.slots[head % ring_size];
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.begin.store(begin, std::memory_order_relaxed);
+  slot.duration.store(end - begin, std::memory_order_relaxed);
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<Tracer::Event> Tracer::GetEvents() {
+  const std::int64_t start = origin.load(std::memory_order_relaxed);
+  std::vector<Event> events;
+  {
+    std::lock_guard lock(registry_mutex);
+    for (const auto &ring : registry) {
+      const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+      for (std::uint64_t index = head > ring_size ? head - ring_size : 0;
+           index < head; ++index) {
+        const auto &slot = ring->slots[index % ring_size];
+        events.push_back({slot.name.load(std::memory_order_relaxed),
+                          slot.begin.load(std::memory_order_relaxed) - start,
+                          slot.duration.load(std::memory_order_relaxed),
+                          ring->thread});
+      }
+    }
+  }
+  std::sort(events.begin(), events.end(),
+            [](const Event &left, const Event &right) {
+              return left.thread != right.thread ? left.thread < right.thread
+                                                 : left.begin < right.begin;
+            });
+  return events;
+}
+
+std::uint64_t Tracer::GetDropped() {
+  std::lock_guard lock(registry_mutex);
+  std::uint64_t dropped = dropped_retired;
+  for (const auto &ring : registry) {
+    const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+    dropped += head > ring_size ? head - ring_size : 0;
+  }
+  return dropped;
+}
+
+std::size_t Tracer::GetRingCount() {
+  std::lock_guard lock(registry_mutex);
+  return registry.size() + free_rings.size();
+}
+
+void Tracer::Write(const std::string &path) {
+  const auto events = GetEvents();
+  std::ofstream file{path};
+  if (!file) {
+    throw std::invalid_argument("Can't open trace file: " + path);
+  }
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  file.setf(std::ios::fixed);
+  file.precision(3);
+  for (std::size_t index = 0; index < events.size(); ++index) {
+    const auto &event = events[index];
+    file << (index == 0 ? "\n" : ",\n") << "{\"name\":\"";
+    WriteEscaped(file, event.name);
+    file << "\",\"cat\":\"s21\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+         << event.thread
+         << ",\"ts\":" << static_cast<double>(event.begin) * 1e-3
+         << ",\"dur\":" << static_cast<double>(event.duration) * 1e-3 << '}';
+  }
+  file << "\n]}\n";
+  file.close();
+}
+
+}  // namespace s21
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "profiler.h"
+
+namespace s21 {
+
+/**
+ * @brief Запись отрезков выполнения в формате Chrome trace
+ * @details Каждый поток пишет отрезки в свой кольцевой буфер без блокировок,
+ * при переполнении затираются самые старые. Запись включается на время
+ * между Start и Stop, выключенная запись стоит одной атомарной загрузки на
+ * отрезок. Буфер завершенного потока хранит отрезки до следующего Start и
+ * затем отдается новым потокам, а если таких буферов больше retired_limit,
+ * самый старый отдается сразу. Без опции сборки S21_PROFILE макрос
+ * S21_TRACE_SCOPE ничего не делает. Файл открывается в Perfetto или
+ * chrome://tracing
+ *
+ * Отрезки пишут:
+ * - ReaderEMNIST::OpenFile и ReaderEMNIST::OpenIdx;
+ * - каждая эпоха и пакет Model::Learn, а также Model::Test;
+ * - ForwardFeed, Learn, LoadWeights и SaveWeights матричной, графовой и
+ *   статической сетей;
+ * - GraphMseWindow::Replot. Это перерисовка графика ошибки во время
+ *   обучения, которая заменила построение графика целиком в AddGraph.
+ */
+class Tracer {
+ public:
+  //! Емкость кольцевого буфера потока в отрезках
+  static constexpr std::size_t ring_size = 1 << 15;
+  //! Наибольшее число хранимых буферов завершенных потоков
+  static constexpr std::size_t retired_limit = 16;
+  //! Отрезок выполнения
+  struct Event {
+    const char *name;       //!< Название, строковый литерал
+    std::int64_t begin;     //!< Начало в наносекундах от Start
+    std::int64_t duration;  //!< Длительность в наносекундах
+    std::uint32_t thread;   //!< Номер потока
+  };
+  //! Отрезок на время жизни объекта
+  class Scope {
+   public:
+    /**
+     * @brief Начать отрезок
+     * @param name Название, должно жить до записи файла
+     */
+    explicit Scope(const char *name) noexcept
+        : name_(IsEnabled() ? name : nullptr), begin_(name_ ? Now() : 0) {}
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+    //! Закончить отрезок
+    ~Scope() {
+      if (name_) {
+        Record(name_, begin_, Now());
+      }
+    }
+
+   private:
+    const char *name_;
+    std::int64_t begin_;
+  };
+  //! Очистить буферы и включить запись
+  static void Start();
+  //! Выключить запись
+  static void Stop() noexcept;
+  //! Включена ли запись
+  static bool IsEnabled() noexcept {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+  /**
+   * @brief Записать отрезок в буфер текущего потока
+   * @param name Название
+   * @param begin Начало в наносекундах steady_clock
+   * @param end Конец в наносекундах steady_clock
+   */
+  static void Record(const char *name, std::int64_t begin,
+                     std::int64_t end) noexcept;
+  //! Получить отрезки всех потоков, упорядоченные по потоку и началу
+  static std::vector<Event> GetEvents();
+  /**
+   * @brief Получить количество потерянных отрезков
+   * @details Считаются затертые при переполнении буфера и отрезки старых
+   * завершенных потоков сверх retired_limit
+   */
+  static std::uint64_t GetDropped();
+  //! Получить количество выделенных буферов потоков
+  static std::size_t GetRingCount();
+  /**
+   * @brief Записать отрезки в файл формата Chrome trace JSON
+   * @details Вызывается после Stop, иначе отрезки, записываемые прямо во
+   * время сохранения, могут попасть в файл частично
+   * @param path Путь до файла
+   */
+  static void Write(const std::string &path);
+  //! Текущее время steady_clock в наносекундах
+  static std::int64_t Now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+ private:
+  inline static std::atomic<bool> enabled_{false};
+};
+
+}  // namespace s21
+
+#ifdef S21_PROFILE
+//! Записать отрезок до конца текущего блока
+#define S21_TRACE_SCOPE(name)                                      \
+  const ::s21::Tracer::Scope S21_PROFILE_CONCAT(s21_trace_scope_, \
+                                                __LINE__)(name)
+#else
+#define S21_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
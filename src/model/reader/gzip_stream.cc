@@ -0,0 +1,396 @@
+#include "gzip_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace s21 {
+
+namespace {
+
+// Размер блока чтения файла
+constexpr std::size_t input_size = 1 << 16;
+// Размер окна deflate
+constexpr std::size_t window_size = 1 << 15;
+
+constexpr std::uint16_t length_base[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::uint8_t length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+                                           1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                           4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::uint16_t distance_base[30] = {
+    1,   2,   3,   4,   5,   7,    9,    13,   17,   25,
+    33,  49,  65,  97,  129, 193,  257,  385,  513,  769,
+    1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::uint8_t distance_extra[30] = {0, 0, 0,  0,  1,  1,  2,  2,
+                                             3, 3, 4,  4,  5,  5,  6,  6,
+                                             7, 7, 8,  8,  9,  9,  10, 10,
+                                             11, 11, 12, 12, 13, 13};
+constexpr std::uint8_t code_length_order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+const std::array<std::uint32_t, 256> &CrcTable() {
+  static const auto table = [] {
+    std::array<std::uint32_t, 256> result{};
+    for (std::uint32_t index = 0; index < 256; ++index) {
+      std::uint32_t crc = index;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+      }
+      result[index] = crc;
+    }
+    return result;
+  }();
+  return table;
+}
+
+}  // namespace
+
+void GzipStream::Huffman::Build(const std::uint8_t *lengths,
+                                const std::size_t count) {
+  counts.fill(0);
+  for (std::size_t symbol = 0; symbol < count; ++symbol) {
+    ++counts[lengths[symbol]];
+  }
+  counts[0] = 0;
+  int left = 1;
+  for (std::size_t length = 1; length < counts.size(); ++length) {
+    left = (left << 1) - counts[length];
+    if (left < 0) {
+      throw std::invalid_argument("Bad gzip: over-subscribed Huffman code.");
+    }
+  }
+  std::array<std::uint16_t, 16> offsets{}, codes{};
+  for (std::size_t length = 1; (length + 1) < offsets.size(); ++length) {
+    offsets[length + 1] = offsets[length] + counts[length];
+  }
+  symbols.assign(offsets.back() + counts.back(), 0);
+  fast.fill(0);
+  std::uint16_t code = 0;
+  for (std::size_t length = 1; length < codes.size(); ++length) {
+    code = static_cast<std::uint16_t>((code + counts[length - 1]) << 1);
+    codes[length] = code;
+  }
+  for (std::size_t symbol = 0; symbol < count; ++symbol) {
+    const unsigned length = lengths[symbol];
+    if (length == 0) {
+      continue;
+    }
+    symbols[offsets[length]++] = static_cast<std::uint16_t>(symbol);
+    const unsigned current = codes[length]++;
+    if (length > fast_bits) {
+      continue;
+    }
+    unsigned reversed = 0;
+    for (unsigned bit = 0; bit < length; ++bit) {
+      reversed |= ((current >> bit) & 1u) << (length - 1 - bit);
+    }
+    for (unsigned index = reversed; index < fast.size();
+         index += 1u << length) {
+      fast[index] = static_cast<std::uint16_t>(symbol << 4 | length);
+    }
+  }
+}
+
+GzipStream::GzipStream(const std::string &path)
+    : file_(path, std::ios::binary),
+      path_(path),
+      input_(input_size),
+      input_pos_(0),
+      input_size_(0),
+      compressed_(false),
+      state_(State::Member),
+      bits_(0),
+      count_bits_(0),
+      last_block_(false),
+      stored_left_(0),
+      literals_(),
+      distances_(),
+      window_(),
+      window_pos_(0),
+      copy_length_(0),
+      copy_distance_(0),
+      crc_(0),
+      member_size_(0) {
+  if (!file_) {
+    throw std::invalid_argument("Can't open file: " + path_);
+  }
+  HasInput();
+  compressed_ = input_size_ >= 2 &&
+                static_cast<unsigned char>(input_[0]) == 0x1f &&
+                static_cast<unsigned char>(input_[1]) == 0x8b;
+  if (compressed_) {
+    window_.resize(window_size);
+  }
+}
+
+bool GzipStream::IsCompressed() const noexcept { return compressed_; }
+
+std::size_t GzipStream::Read(unsigned char *data, const std::size_t size) {
+  std::size_t produced = 0;
+  if (!compressed_) {
+    while (produced < size && HasInput()) {
+      const std::size_t count =
+          std::min(size - produced, input_size_ - input_pos_);
+      std::memcpy(data + produced, input_.data() + input_pos_, count);
+      input_pos_ += count;
+      produced += count;
+    }
+    return produced;
+  }
+  while (produced < size) {
+    if (copy_length_ != 0) {
+      Emit(window_[(window_pos_ - copy_distance_) & (window_size - 1)], data,
+           produced);
+      --copy_length_;
+      continue;
+    }
+    switch (state_) {
+      case State::Member:
+        state_ = ReadHeader() ? State::Block : State::End;
+        break;
+      case State::Block:
+        if (last_block_) {
+          ReadTrailer();
+          state_ = State::Member;
+        } else {
+          ReadBlockHeader();
+        }
+        break;
+      case State::Stored:
+        if (stored_left_ == 0) {
+          state_ = State::Block;
+        } else {
+          Emit(static_cast<unsigned char>(ReadBits(8)), data, produced);
+          --stored_left_;
+        }
+        break;
+      case State::Huffman: {
+        const unsigned symbol = Decode(literals_);
+        if (symbol < 256) {
+          Emit(static_cast<unsigned char>(symbol), data, produced);
+        } else if (symbol == 256) {
+          state_ = State::Block;
+        } else {
+          const unsigned length = symbol - 257;
+          if (length >= 29) {
+            throw std::invalid_argument("Bad gzip: wrong length symbol.");
+          }
+          copy_length_ = length_base[length] + ReadBits(length_extra[length]);
+          const unsigned distance = Decode(distances_);
+          if (distance >= 30) {
+            throw std::invalid_argument("Bad gzip: wrong distance symbol.");
+          }
+          copy_distance_ =
+              distance_base[distance] + ReadBits(distance_extra[distance]);
+          if (copy_distance_ > std::min(window_pos_, window_size)) {
+            throw std::invalid_argument("Bad gzip: distance is too far.");
+          }
+        }
+        break;
+      }
+      case State::End:
+        return produced;
+    }
+  }
+  return produced;
+}
+
+void GzipStream::ReadExact(unsigned char *data, const std::size_t size) {
+  if (Read(data, size) != size) {
+    throw std::invalid_argument("Unexpected end of file: " + path_);
+  }
+}
+
+unsigned GzipStream::NextByte() {
+  if (!HasInput()) {
+    throw std::invalid_argument("Bad gzip: truncated " + path_);
+  }
+  return static_cast<unsigned char>(input_[input_pos_++]);
+}
+
+bool GzipStream::HasInput() {
+  if (input_pos_ < input_size_) {
+    return true;
+  }
+  file_.read(input_.data(), static_cast<std::streamsize>(input_.size()));
+  input_size_ = static_cast<std::size_t>(file_.gcount());
+  input_pos_ = 0;
+  return input_size_ != 0;
+}
+
+std::uint32_t GzipStream::ReadBits(const unsigned count) {
+  while (count_bits_ < count) {
+    bits_ |= static_cast<std::uint64_t>(NextByte()) << count_bits_;
+    count_bits_ += 8;
+  }
+  const auto value =
+      static_cast<std::uint32_t>(bits_ & ((std::uint64_t{1} << count) - 1));
+  bits_ >>= count;
+  count_bits_ -= count;
+  return value;
+}
+
+void GzipStream::AlignToByte() noexcept {
+  bits_ >>= count_bits_ % 8;
+  count_bits_ -= count_bits_ % 8;
+}
+
+unsigned GzipStream::Decode(const Huffman &huffman) {
+  while (count_bits_ < Huffman::fast_bits && HasInput()) {
+    bits_ |= static_cast<std::uint64_t>(NextByte()) << count_bits_;
+    count_bits_ += 8;
+  }
+  const unsigned entry =
+      huffman.fast[bits_ & ((1u << Huffman::fast_bits) - 1)];
+  if (entry != 0 && (entry & 15u) <= count_bits_) {
+    bits_ >>= entry & 15u;
+    count_bits_ -= entry & 15u;
+    return entry >> 4;
+  }
+  int code = 0, first = 0, index = 0;
+  for (std::size_t length = 1; length < huffman.counts.size(); ++length) {
+    code |= static_cast<int>(ReadBits(1));
+    const int count = huffman.counts[length];
+    if (code - count < first) {
+      return huffman.symbols[index + (code - first)];
+    }
+    index += count;
+    first = (first + count) << 1;
+    code <<= 1;
+  }
+  throw std::invalid_argument("Bad gzip: wrong Huffman code.");
+}
+
+bool GzipStream::ReadHeader() {
+  AlignToByte();
+  if (count_bits_ == 0 && !HasInput()) {
+    return false;
+  }
+  if (ReadBits(8) != 0x1f || ReadBits(8) != 0x8b || ReadBits(8) != 8) {
+    throw std::invalid_argument("Bad gzip: wrong header " + path_);
+  }
+  const unsigned flags = ReadBits(8);
+  ReadBits(32);
+  ReadBits(16);
+  if (flags & 4u) {
+    for (std::uint32_t extra = ReadBits(16); extra != 0; --extra) {
+      ReadBits(8);
+    }
+  }
+  for (const unsigned flag : {8u, 16u}) {
+    if (flags & flag) {
+      while (ReadBits(8) != 0) {
+      }
+    }
+  }
+  if (flags & 2u) {
+    ReadBits(16);
+  }
+  last_block_ = false;
+  window_pos_ = 0;
+  crc_ = 0xFFFFFFFFu;
+  member_size_ = 0;
+  return true;
+}
+
+void GzipStream::ReadTrailer() {
+  AlignToByte();
+  const std::uint32_t crc = ReadBits(32), size = ReadBits(32);
+  if (crc != (crc_ ^ 0xFFFFFFFFu) || size != member_size_) {
+    throw std::invalid_argument("Bad gzip: checksum mismatch " + path_);
+  }
+}
+
+void GzipStream::ReadBlockHeader() {
+  last_block_ = ReadBits(1) != 0;
+  switch (ReadBits(2)) {
+    case 0: {
+      AlignToByte();
+      const std::uint32_t length = ReadBits(16), complement = ReadBits(16);
+      if ((length ^ 0xFFFFu) != complement) {
+        throw std::invalid_argument("Bad gzip: wrong stored block length.");
+      }
+      stored_left_ = length;
+      state_ = State::Stored;
+      break;
+    }
+    case 1: {
+      std::uint8_t lengths[288 + 30];
+      std::fill(lengths, lengths + 144, 8);
+      std::fill(lengths + 144, lengths + 256, 9);
+      std::fill(lengths + 256, lengths + 280, 7);
+      std::fill(lengths + 280, lengths + 288, 8);
+      std::fill(lengths + 288, lengths + 318, 5);
+      literals_.Build(lengths, 288);
+      distances_.Build(lengths + 288, 30);
+      state_ = State::Huffman;
+      break;
+    }
+    case 2:
+      ReadDynamicTables();
+      state_ = State::Huffman;
+      break;
+    default:
+      throw std::invalid_argument("Bad gzip: wrong block type.");
+  }
+}
+
+void GzipStream::ReadDynamicTables() {
+  const std::size_t count_literals = ReadBits(5) + 257,
+                    count_distances = ReadBits(5) + 1,
+                    count_codes = ReadBits(4) + 4;
+  if (count_literals > 286 || count_distances > 30) {
+    throw std::invalid_argument("Bad gzip: too many codes.");
+  }
+  std::uint8_t lengths[286 + 30] = {};
+  for (std::size_t index = 0; index < count_codes; ++index) {
+    lengths[code_length_order[index]] = static_cast<std::uint8_t>(ReadBits(3));
+  }
+  Huffman code_lengths;
+  code_lengths.Build(lengths, 19);
+  std::fill(lengths, lengths + 19, 0);
+  const std::size_t total = count_literals + count_distances;
+  for (std::size_t index = 0; index < total;) {
+    const unsigned symbol = Decode(code_lengths);
+    if (symbol < 16) {
+      lengths[index++] = static_cast<std::uint8_t>(symbol);
+      continue;
+    }
+    std::uint8_t value = 0;
+    std::size_t repeat = 0;
+    if (symbol == 16) {
+      if (index == 0) {
+        throw std::invalid_argument("Bad gzip: repeat without length.");
+      }
+      value = lengths[index - 1];
+      repeat = 3 + ReadBits(2);
+    } else if (symbol == 17) {
+      repeat = 3 + ReadBits(3);
+    } else {
+      repeat = 11 + ReadBits(7);
+    }
+    if (index + repeat > total) {
+      throw std::invalid_argument("Bad gzip: too many code lengths.");
+    }
+    std::fill(lengths + index, lengths + index + repeat, value);
+    index += repeat;
+  }
+  if (lengths[256] == 0) {
+    throw std::invalid_argument("Bad gzip: no end of block code.");
+  }
+  literals_.Build(lengths, count_literals);
+  distances_.Build(lengths + count_literals, count_distances);
+}
+
+void GzipStream::Emit(const unsigned char byte, unsigned char *data,
+                      std::size_t &produced) {
+  window_[window_pos_++ & (window_size - 1)] = byte;
+  crc_ = CrcTable()[(crc_ ^ byte) & 0xFFu] ^ (crc_ >> 8);
+  ++member_size_;
+  data[produced++] = byte;
+}
+
+}  // namespace s21
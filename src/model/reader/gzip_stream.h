@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Поток байтов файла с распаковкой gzip на лету
+ * @details Файл читается блоками, сжатый gzip файл распаковывается
+ * встроенным декодером deflate по мере чтения, несжатый отдается как есть.
+ * Контрольная сумма и размер каждого члена gzip проверяются в конце члена
+ */
+class GzipStream {
+ public:
+  //! Удален дефолтный конструктор
+  GzipStream() = delete;
+  /**
+   * @brief Открыть файл
+   * @param path Путь до файла
+   */
+  explicit GzipStream(const std::string &path);
+  //! Удален конструктор копирования
+  GzipStream(const GzipStream &) = delete;
+  //! Удален конструктор переноса
+  GzipStream(GzipStream &&) noexcept = delete;
+  //! Удален оператор копирования
+  GzipStream &operator=(const GzipStream &) = delete;
+  //! Удален оператор переноса
+  GzipStream &operator=(GzipStream &&) noexcept = delete;
+  //! Дефолтный деструктор
+  ~GzipStream() = default;
+  //! Сжат ли файл gzip
+  bool IsCompressed() const noexcept;
+  /**
+   * @brief Прочитать байты
+   * @param data Буфер
+   * @param size Размер буфера
+   * @return Количество прочитанных байтов, меньше size только в конце файла
+   */
+  std::size_t Read(unsigned char *data, std::size_t size);
+  /**
+   * @brief Прочитать ровно заданное количество байтов
+   * @details Бросает исключение, если файл закончился раньше
+   * @param data Буфер
+   * @param size Количество байтов
+   */
+  void ReadExact(unsigned char *data, std::size_t size);
+
+ private:
+  //! Состояние декодера
+  enum class State { Member, Block, Stored, Huffman, End };
+  //! Канонический код Хаффмана
+  struct Huffman {
+    //! Количество бит быстрой таблицы
+    static constexpr unsigned fast_bits = 9;
+    /**
+     * @brief Построить код по длинам кодов символов
+     * @param lengths Длины кодов
+     * @param count Количество символов
+     */
+    void Build(const std::uint8_t *lengths, std::size_t count);
+    std::array<std::uint16_t, 16> counts{};  //!< Кодов каждой длины
+    std::vector<std::uint16_t> symbols;      //!< Символы по порядку кодов
+    //! Символ и длина коротких кодов по следующим fast_bits битам
+    std::array<std::uint16_t, 1 << fast_bits> fast{};
+  };
+  //! Прочитать следующий байт файла
+  unsigned NextByte();
+  //! Есть ли еще байты в файле
+  bool HasInput();
+  //! Прочитать count бит, младшие первыми
+  std::uint32_t ReadBits(unsigned count);
+  //! Отбросить биты до границы байта
+  void AlignToByte() noexcept;
+  //! Раскодировать символ
+  unsigned Decode(const Huffman &huffman);
+  //! Прочитать заголовок члена gzip, false в конце файла
+  bool ReadHeader();
+  //! Прочитать и проверить конец члена gzip
+  void ReadTrailer();
+  //! Прочитать заголовок блока deflate
+  void ReadBlockHeader();
+  //! Прочитать коды Хаффмана динамического блока
+  void ReadDynamicTables();
+  //! Записать распакованный байт
+  void Emit(unsigned char byte, unsigned char *data, std::size_t &produced);
+
+  std::ifstream file_;
+  std::string path_;
+  std::vector<char> input_;
+  std::size_t input_pos_, input_size_;
+  bool compressed_;
+  State state_;
+  std::uint64_t bits_;
+  unsigned count_bits_;
+  bool last_block_;
+  std::size_t stored_left_;
+  Huffman literals_, distances_;
+  std::vector<unsigned char> window_;
+  std::size_t window_pos_, copy_length_, copy_distance_;
+  std::uint32_t crc_, member_size_;
+};
+
+}  // namespace s21
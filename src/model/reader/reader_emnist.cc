@@ -1,13 +1,68 @@
 #include "reader_emnist.h"
 
+#include <array>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 
+#include "../profiler/profiler.h"
+#include "../profiler/tracer.h"
+#include "gzip_stream.h"
+
 namespace s21 {
 
+namespace {
+
+constexpr std::uint32_t idx_images_magic = 0x00000803;
+constexpr std::uint32_t idx_labels_magic = 0x00000801;
+const std::string idx_images_name = "images-idx3-ubyte";
+const std::string idx_labels_name = "labels-idx1-ubyte";
+
+std::uint32_t ReadBigEndian(GzipStream &stream) {
+  std::array<unsigned char, 4> bytes;
+  stream.ReadExact(bytes.data(), bytes.size());
+  return static_cast<std::uint32_t>(bytes[0]) << 24 |
+         static_cast<std::uint32_t>(bytes[1]) << 16 |
+         static_cast<std::uint32_t>(bytes[2]) << 8 | bytes[3];
+}
+
+bool IsIdxImages(const std::string &path) {
+  if (!std::ifstream{path}) {
+    return false;
+  }
+  GzipStream stream{path};
+  std::array<unsigned char, 4> magic{};
+  return stream.Read(magic.data(), magic.size()) == magic.size() &&
+         magic == std::array<unsigned char, 4>{0, 0, 8, 3};
+}
+
+std::string GetLabelsPath(const std::string &images_path) {
+  const std::size_t name = images_path.rfind(idx_images_name);
+  if (name == std::string::npos) {
+    throw std::invalid_argument("Can't find IDX labels for " + images_path);
+  }
+  std::string path = images_path;
+  path.replace(name, idx_images_name.size(), idx_labels_name);
+  if (!std::ifstream{path}) {
+    const std::string gz = ".gz";
+    const bool compressed = path.size() > gz.size() &&
+                            path.compare(path.size() - gz.size(), gz.size(),
+                                         gz) == 0;
+    path = compressed ? path.substr(0, path.size() - gz.size()) : path + gz;
+  }
+  return path;
+}
+
+}  // namespace
+
 ReaderEMNIST::ReaderEMNIST(const std::string &path) { OpenFile(path); }
 
+ReaderEMNIST::ReaderEMNIST(const std::string &images_path,
+                           const std::string &labels_path) {
+  OpenIdx(images_path, labels_path);
+}
+
 std::vector<ReaderEMNIST::EmnistValue> ReaderEMNIST::GetVector(
     std::size_t start, std::size_t end) const {
   end = std::min(end, lines_.size());
@@ -24,6 +79,12 @@ std::vector<ReaderEMNIST::EmnistValue> ReaderEMNIST::GetVector(
 }
 
 void ReaderEMNIST::OpenFile(const std::string &path) {
+  S21_TRACE_SCOPE("ReaderEMNIST::OpenFile");
+  if (IsIdxImages(path)) {
+    OpenIdx(path, GetLabelsPath(path));
+    return;
+  }
+  S21_PROFILE_SCOPE(Parse);
   lines_.clear();
   std::ifstream file{path};
   std::string line, num;
@@ -45,7 +106,43 @@ void ReaderEMNIST::OpenFile(const std::string &path) {
   }
 }
 
-ReaderEMNIST::EmnistValue ReaderEMNIST::operator[](std::size_t index) const {
+void ReaderEMNIST::OpenIdx(const std::string &images_path,
+                           const std::string &labels_path) {
+  S21_TRACE_SCOPE("ReaderEMNIST::OpenIdx");
+  S21_PROFILE_SCOPE(Parse);
+  lines_.clear();
+  GzipStream images{images_path}, labels{labels_path};
+  if (ReadBigEndian(images) != idx_images_magic) {
+    throw std::invalid_argument("Bad IDX images: " + images_path);
+  }
+  if (ReadBigEndian(labels) != idx_labels_magic) {
+    throw std::invalid_argument("Bad IDX labels: " + labels_path);
+  }
+  const std::size_t count = ReadBigEndian(images);
+  const std::size_t rows = ReadBigEndian(images), cols = ReadBigEndian(images);
+  if (rows * cols != count_sensors) {
+    throw std::invalid_argument("Bad IDX images: wrong image size.");
+  }
+  if (ReadBigEndian(labels) != count) {
+    throw std::invalid_argument("IDX images and labels counts don't match.");
+  }
+  lines_.reserve(std::min<std::size_t>(count, 1 << 20));
+  std::array<unsigned char, count_sensors> pixels;
+  for (std::size_t index = 0; index < count; ++index) {
+    unsigned char label = 0;
+    images.ReadExact(pixels.data(), pixels.size());
+    labels.ReadExact(&label, 1);
+    EmnistValue item(Matrix<float>(count_sensors, 1),
+                     static_cast<std::size_t>(label) - 1);
+    for (std::size_t sensor = 0; sensor < count_sensors; ++sensor) {
+      item.first(sensor, 0) = static_cast<float>(pixels[sensor]) / 255.f;
+    }
+    lines_.push_back(std::move(item));
+  }
+}
+
+const ReaderEMNIST::EmnistValue &ReaderEMNIST::operator[](
+    std::size_t index) const {
   return lines_[index];
 }
 
@@ -26,15 +26,33 @@ class ReaderEMNIST {
    * @param path Путь до файла
    */
   explicit ReaderEMNIST(const std::string &path);
+  /**
+   * @brief Конструктор с открытием файлов IDX
+   * @param images_path Путь до файла изображений
+   * @param labels_path Путь до файла меток
+   */
+  ReaderEMNIST(const std::string &images_path, const std::string &labels_path);
   //! Дефолтный деструктор
   ~ReaderEMNIST() = default;
   /**
    * @brief Прочитать значения EmnistValue из файла
+   * @details Файл CSV или файл изображений IDX, в том числе сжатый gzip.
+   * Файл меток IDX ищется рядом, с labels-idx1-ubyte вместо
+   * images-idx3-ubyte в имени
    * @param path Путь до файла
    */
   void OpenFile(const std::string &path);
+  /**
+   * @brief Прочитать значения EmnistValue из файлов IDX
+   * @details Файлы могут быть сжаты gzip и читаются потоком. Изображения
+   * остаются в транспонированном порядке EMNIST, а метки сдвигаются к нулю,
+   * как и при чтении CSV
+   * @param images_path Путь до файла изображений
+   * @param labels_path Путь до файла меток
+   */
+  void OpenIdx(const std::string &images_path, const std::string &labels_path);
   //! Получение значения EMNIST по индексу
-  EmnistValue operator[](std::size_t) const;
+  const EmnistValue &operator[](std::size_t) const;
   //! Размер вектора EMNIST данных
   std::size_t Size() const;
   //! Получить вектор EMNIST с заданными рамками
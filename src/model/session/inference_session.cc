@@ -0,0 +1,46 @@
+#include "inference_session.h"
+
+namespace s21 {
+
+InferenceSession::InferenceSession(BaseNetwork *network)
+    : network_(network), updates_(0), valid_(false) {}
+
+Matrix<float> InferenceSession::ForwardFeed(const Matrix<float> &sensors) {
+  if (!valid_ || updates_ >= refresh_period ||
+      sensors_.GetRows() != sensors.GetRows()) {
+    return Refresh(sensors);
+  }
+  changed_.clear();
+  for (std::size_t index = 0; index < sensors.GetRows(); ++index) {
+    if (sensors(index, 0) != sensors_(index, 0)) {
+      changed_.push_back(index);
+    }
+  }
+  if (changed_.size() * 2 > sensors.GetRows()) {
+    return Refresh(sensors);
+  }
+  for (const std::size_t index : changed_) {
+    network_->AddFirstLayerDelta(first_layer_, index,
+                                 sensors(index, 0) - sensors_(index, 0));
+    sensors_(index, 0) = sensors(index, 0);
+  }
+  if (!changed_.empty()) {
+    ++updates_;
+  }
+  return network_->ForwardFeedFromFirstLayer(first_layer_);
+}
+
+void InferenceSession::Reset(BaseNetwork *network) {
+  network_ = network;
+  valid_ = false;
+}
+
+Matrix<float> InferenceSession::Refresh(const Matrix<float> &sensors) {
+  first_layer_ = network_->GetFirstLayerSum(sensors);
+  sensors_ = sensors;
+  updates_ = 0;
+  valid_ = true;
+  return network_->ForwardFeedFromFirstLayer(first_layer_);
+}
+
+}  // namespace s21
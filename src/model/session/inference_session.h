@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include "../networks/base/base_network.h"
+
+namespace s21 {
+
+//! Сессия инкрементального прогона для рисования в реальном времени
+class InferenceSession {
+ public:
+  //! Удален дефолтный конструктор
+  InferenceSession() = delete;
+  /**
+   * @brief Конструктор сессии для заданного перцептрона
+   * @param network Указатель на перцептрон
+   */
+  explicit InferenceSession(BaseNetwork *network);
+  //! Удален конструктор копирования
+  InferenceSession(const InferenceSession &) = delete;
+  //! Удален конструктор переноса
+  InferenceSession(InferenceSession &&) noexcept = delete;
+  //! Удален оператор копирования
+  InferenceSession &operator=(const InferenceSession &) = delete;
+  //! Удален оператор переноса
+  InferenceSession &operator=(InferenceSession &&) noexcept = delete;
+  //! Дефолтный деструктор
+  ~InferenceSession() = default;
+  /**
+   * @brief Обработать входные сенсоры
+   * @details Суммы первого скрытого слоя пересчитываются только по
+   * изменившимся с прошлого вызова сенсорам, верхние слои прогоняются целиком
+   * @param sensors Входные сенсоры
+   * @return Результативная матрица прогона данных по весам перцептрона
+   */
+  Matrix<float> ForwardFeed(const Matrix<float> &sensors);
+  /**
+   * @brief Сбросить закешированные суммы
+   * @details Вызывается при любом изменении весов перцептрона
+   * @param network Указатель на актуальный перцептрон
+   */
+  void Reset(BaseNetwork *network);
+
+ private:
+  /**
+   * @brief Полностью пересчитать суммы первого скрытого слоя
+   * @param sensors Входные сенсоры
+   * @return Результативная матрица прогона данных по весам перцептрона
+   */
+  Matrix<float> Refresh(const Matrix<float> &sensors);
+  //! Количество инкрементальных прогонов до полного пересчета сумм
+  static constexpr std::size_t refresh_period = 512;
+  //! Перцептрон
+  BaseNetwork *network_;
+  //! Сенсоры прошлого прогона
+  Matrix<float> sensors_;
+  //! Суммы первого скрытого слоя прошлого прогона
+  Matrix<float> first_layer_;
+  //! Индексы изменившихся сенсоров
+  std::vector<std::size_t> changed_;
+  //! Количество инкрементальных прогонов после полного пересчета
+  std::size_t updates_;
+  //! Актуальны ли закешированные суммы
+  bool valid_;
+};
+
+}  // namespace s21
@@ -0,0 +1,41 @@
+#include "network_replica.h"
+
+#include <stdexcept>
+
+namespace s21 {
+
+NetworkReplica::NetworkReplica(const Published<BaseNetwork> &published)
+    : published_(published), network_(), session_(nullptr), version_(0) {
+  Refresh();
+}
+
+Matrix<float> NetworkReplica::ForwardFeed(const Matrix<float> &sensors) {
+  Refresh();
+  return network_->ForwardFeed(sensors);
+}
+
+Matrix<float> NetworkReplica::ForwardFeedIncremental(
+    const Matrix<float> &sensors) {
+  Refresh();
+  return session_.ForwardFeed(sensors);
+}
+
+bool NetworkReplica::Refresh() {
+  const auto version = published_.Acquire();
+  if (!version) {
+    throw std::invalid_argument("No network has been published yet.");
+  }
+  if (network_ && version->number == version_) {
+    return false;
+  }
+  if (!network_ || !network_->CopyWeightsFrom(*version->value)) {
+    network_ = version->value->Clone();
+  }
+  session_.Reset(network_.get());
+  version_ = version->number;
+  return true;
+}
+
+std::uint64_t NetworkReplica::GetVersion() const { return version_; }
+
+}  // namespace s21
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+
+#include "inference_session.h"
+#include "published.h"
+
+namespace s21 {
+
+/**
+ * @brief Копия опубликованного перцептрона для распознавания в своем потоке
+ * @details Перед каждым прогоном проверяется номер опубликованной версии.
+ * При смене версии веса копируются на место, а при смене типа или размеров
+ * перцептрона копия создается заново. Прогоны не блокируют ни обучение, ни
+ * загрузку весов в модели. Один объект используется одним потоком
+ */
+class NetworkReplica {
+ public:
+  /**
+   * @brief Конструктор
+   * @param published Опубликованный перцептрон, должен пережить копию
+   */
+  explicit NetworkReplica(const Published<BaseNetwork> &published);
+  //! Удален конструктор копирования
+  NetworkReplica(const NetworkReplica &) = delete;
+  //! Удален оператор копирования
+  NetworkReplica &operator=(const NetworkReplica &) = delete;
+  /**
+   * @brief Обработать входные сенсоры последней версией перцептрона
+   * @param sensors Входные сенсоры
+   */
+  Matrix<float> ForwardFeed(const Matrix<float> &sensors);
+  /**
+   * @brief Обработать входные сенсоры инкрементально
+   * @details Кеш сумм первого слоя сбрасывается при смене версии
+   * @param sensors Входные сенсоры
+   */
+  Matrix<float> ForwardFeedIncremental(const Matrix<float> &sensors);
+  /**
+   * @brief Взять последнюю опубликованную версию
+   * @return Сменилась ли версия
+   */
+  bool Refresh();
+  //! Получить номер используемой версии
+  std::uint64_t GetVersion() const;
+
+ private:
+  //! Опубликованный перцептрон
+  const Published<BaseNetwork> &published_;
+  //! Копия перцептрона
+  std::unique_ptr<BaseNetwork> network_;
+  //! Сессия инкрементального прогона копии
+  InferenceSession session_;
+  //! Номер используемой версии
+  std::uint64_t version_;
+};
+
+}  // namespace s21
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace s21 {
+
+/**
+ * @brief Опубликованная версия объекта в стиле RCU
+ * @details Писатель публикует новую неизменяемую версию атомарной заменой
+ * указателя. Читатель захватывает текущую версию и работает с ней сколько
+ * угодно: старая версия живет, пока ее держит хоть один читатель, и
+ * удаляется последним из них. Ни писатель, ни читатели не ждут друг друга
+ * @tparam T Тип объекта
+ */
+template <class T>
+class Published {
+ public:
+  //! Версия объекта
+  struct Version {
+    std::shared_ptr<const T> value;  //!< Неизменяемый объект
+    std::uint64_t number;            //!< Номер версии, растет с каждой
+  };
+  //! Дефолтный конструктор, до первой публикации версии нет
+  Published() = default;
+  //! Удален конструктор копирования
+  Published(const Published &) = delete;
+  //! Удален оператор копирования
+  Published &operator=(const Published &) = delete;
+  /**
+   * @brief Опубликовать новую версию
+   * @details Писатель может повторно использовать объект старой версии, когда
+   * кроме него объект никто не держит
+   * @param value Объект, пока версия захвачена, он не изменяется
+   */
+  void Publish(std::shared_ptr<const T> value) {
+    auto version = std::make_shared<const Version>(
+        Version{std::move(value), count_.fetch_add(1) + 1});
+    std::atomic_store_explicit(&current_, std::move(version),
+                               std::memory_order_release);
+  }
+  /**
+   * @brief Захватить текущую версию
+   * @return Версия, пустой указатель до первой публикации
+   */
+  std::shared_ptr<const Version> Acquire() const {
+    return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+  }
+  //! Получить номер последней опубликованной версии
+  std::uint64_t GetVersion() const { return count_.load(); }
+
+ private:
+  //! Текущая версия
+  std::shared_ptr<const Version> current_;
+  //! Количество публикаций
+  std::atomic<std::uint64_t> count_{0};
+};
+
+}  // namespace s21
@@ -0,0 +1,203 @@
+#include "sweep.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "loader/random.h"
+
+namespace s21 {
+
+namespace {
+
+void CheckSpace(const Sweep::SearchSpace &space) {
+  if (space.networks.empty() || space.count_layers.empty() ||
+      space.count_neurons.empty() || space.learning_rates.empty()) {
+    throw std::invalid_argument("Search space has an empty dimension.");
+  }
+}
+
+}  // namespace
+
+Sweep::Sweep(const Options &options) : options_(options) {}
+
+std::vector<Sweep::Config> Sweep::Grid(const SearchSpace &space) {
+  CheckSpace(space);
+  std::vector<Config> configs;
+  for (const auto network : space.networks) {
+    for (const auto count_layers : space.count_layers) {
+      for (const auto count_neurons : space.count_neurons) {
+        for (const auto learning_rate : space.learning_rates) {
+          configs.push_back({network, count_layers, count_neurons,
+                             learning_rate});
+        }
+      }
+    }
+  }
+  return configs;
+}
+
+std::vector<Sweep::Config> Sweep::Random(const SearchSpace &space,
+                                         const std::size_t count,
+                                         const std::uint64_t seed) {
+  CheckSpace(space);
+  const auto [min_rate, max_rate] = std::minmax_element(
+      space.learning_rates.begin(), space.learning_rates.end());
+  const float log_min = std::log(std::max(*min_rate, 1e-6f)),
+              log_max = std::log(std::max(*max_rate, 1e-6f));
+  std::uint64_t state = seed;
+  auto next = [&state] { return state = SplitMix(state); };
+  std::vector<Config> configs(count);
+  for (auto &config : configs) {
+    config.network = space.networks[next() % space.networks.size()];
+    config.count_layers =
+        space.count_layers[next() % space.count_layers.size()];
+    config.count_neurons =
+        space.count_neurons[next() % space.count_neurons.size()];
+    config.learning_rate =
+        std::exp(log_min + UnitFloat(next()) * (log_max - log_min));
+  }
+  return configs;
+}
+
+std::vector<Sweep::Result> Sweep::Run(const std::vector<Config> &configs,
+                                      const ReaderEMNIST &train,
+                                      const ReaderEMNIST &test) const {
+  std::vector<Result> results(configs.size());
+  const auto prune_step = static_cast<std::size_t>(
+      static_cast<float>(train.Size()) * options_.prune_fraction);
+  std::mutex reports_mutex;
+  std::vector<double> reports;
+  auto prune = [&](const double mse) {
+    if (!std::isfinite(mse) ||
+        (options_.prune_mse > 0. && mse > options_.prune_mse)) {
+      return true;
+    }
+    if (!options_.median_pruning) {
+      return false;
+    }
+    std::lock_guard lock(reports_mutex);
+    bool worse = false;
+    if (reports.size() >= std::max(options_.median_min_reports, 1lu)) {
+      auto sorted = reports;
+      auto median = sorted.begin() + sorted.size() / 2;
+      std::nth_element(sorted.begin(), median, sorted.end());
+      worse = mse > *median;
+    }
+    reports.push_back(mse);
+    return worse;
+  };
+  auto run = [&](const Config &config, Result &result) {
+    result = Result{config, config.network, {}, 0., 0., 0, false, {}};
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      Model model;
+      if (config.network == Network::Graph) {
+        model.SetGraphNetwork();
+      } else if (config.network == Network::Static) {
+        model.SetStaticNetwork();
+      }
+      model.SetHiddenLayers(std::vector<std::size_t>(config.count_layers,
+                                                    config.count_neurons));
+      result.engine = model.IsStaticNetwork()  ? Network::Static
+                      : model.IsGraphNetwork() ? Network::Graph
+                                               : Network::Matrix;
+      model.SetLearningRate(config.learning_rate);
+      model.SetSeed(options_.seed);
+      model.ResetWeights();
+      double sum = 0.;
+      std::size_t steps = 0;
+      const std::function<bool(double)> observe = [&](const double mse) {
+        sum += mse;
+        if (++steps != prune_step) {
+          return true;
+        }
+        result.pruned = prune(sum / static_cast<double>(steps));
+        return !result.pruned;
+      };
+      for (std::size_t epoch = 0; epoch < std::max(options_.count_epoch, 1lu);
+           ++epoch) {
+        model.Learn(train, epoch == 0 ? observe : nullptr);
+        if (result.pruned) {
+          break;
+        }
+        ++result.epochs;
+      }
+      result.train_sec = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+      if (!result.pruned && test.Size() != 0) {
+        result.test = model.Test(test);
+        result.latency_ms =
+            result.test.time_sec * 1000. / static_cast<double>(test.Size());
+      }
+    } catch (const std::exception &error) {
+      result.pruned = true;
+      result.error = error.what();
+    }
+  };
+  std::atomic<std::size_t> next{0};
+  auto worker = [&] {
+    for (std::size_t index = next++; index < configs.size(); index = next++) {
+      run(configs[index], results[index]);
+    }
+  };
+  std::size_t count_threads = options_.count_threads;
+  if (count_threads == 0) {
+    count_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  std::vector<std::thread> threads;
+  for (std::size_t index = 0;
+       index < std::min(count_threads, configs.size()); ++index) {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::stable_sort(results.begin(), results.end(),
+                   [](const Result &left, const Result &right) {
+                     if (left.pruned != right.pruned) {
+                       return right.pruned;
+                     }
+                     if (left.test.average_accuracy !=
+                         right.test.average_accuracy) {
+                       return left.test.average_accuracy >
+                              right.test.average_accuracy;
+                     }
+                     return left.test.f_measure > right.test.f_measure;
+                   });
+  return results;
+}
+
+void Sweep::SaveResults(const std::vector<Result> &results,
+                        const std::string &path) {
+  std::ofstream file{path};
+  file << "rank,network,layers,neurons,learning_rate,accuracy,precision,"
+          "recall,f_measure,train_sec,latency_ms,epochs,status\n";
+  for (std::size_t index = 0; index < results.size(); ++index) {
+    const auto &result = results[index];
+    file << index + 1 << ','
+         << (result.engine == Network::Graph    ? "graph"
+             : result.engine == Network::Static ? "static"
+                                                 : "matrix")
+         << ',' << result.config.count_layers << ','
+         << result.config.count_neurons << ','
+         << result.config.learning_rate << ','
+         << result.test.average_accuracy << ',' << result.test.precision << ','
+         << result.test.recall << ',' << result.test.f_measure << ','
+         << result.train_sec << ',' << result.latency_ms << ','
+         << result.epochs << ','
+         << (!result.error.empty() ? "error"
+             : result.pruned       ? "pruned"
+                                   : "ok")
+         << '\n';
+  }
+  file.close();
+}
+
+}  // namespace s21
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "model.h"
+
+namespace s21 {
+
+/**
+ * @brief Перебор гиперпараметров модели
+ * @details Конфигурации обучаются и тестируются параллельно на общих
+ * ридерах, заведомо плохие конфигурации отсекаются по ошибке начала первой
+ * эпохи
+ */
+class Sweep {
+ public:
+  //! Тип перцептрона
+  enum class Network { Matrix, Graph, Static };
+  //! Конфигурация модели
+  struct Config {
+    Network network;             //!< Тип перцептрона
+    std::size_t count_layers;    //!< Количество скрытых слоев
+    std::size_t count_neurons;   //!< Количество нейронов в скрытом слое
+    float learning_rate;         //!< Скорость обучения
+  };
+  //! Пространство поиска
+  struct SearchSpace {
+    std::vector<Network> networks{Network::Matrix};      //!< Типы перцептрона
+    std::vector<std::size_t> count_layers{2, 3, 4, 5};   //!< Числа слоев
+    std::vector<std::size_t> count_neurons{64};          //!< Числа нейронов
+    std::vector<float> learning_rates{0.2f};             //!< Скорости обучения
+  };
+  //! Параметры перебора
+  struct Options {
+    std::size_t count_epoch = 1;    //!< Количество эпох обучения
+    std::size_t count_threads = 0;  //!< Количество потоков, 0 - по ядрам
+    std::uint64_t seed = 42;        //!< Зерно перемешивания выборки
+    //! Доля первой эпохи, после которой принимается решение об отсечении
+    float prune_fraction = 0.25f;
+    //! Предельная средняя ошибка к точке отсечения, 0 - без предела
+    double prune_mse = 0.;
+    //! Отсекать конфигурации хуже медианы уже дошедших до точки отсечения
+    bool median_pruning = true;
+    //! Минимум дошедших конфигураций для сравнения с медианой
+    std::size_t median_min_reports = 3;
+  };
+  //! Результат конфигурации
+  struct Result {
+    Config config;               //!< Конфигурация
+    Network engine;              //!< Перцептрон, работавший на самом деле
+    Model::TestOutput test;      //!< Метрики на тестовой выборке
+    double train_sec;            //!< Время обучения
+    double latency_ms;           //!< Среднее время распознавания примера
+    std::size_t epochs;          //!< Количество пройденных эпох
+    bool pruned;                 //!< Отсечена ли конфигурация
+    std::string error;           //!< Причина отказа конфигурации
+  };
+  //! Дефолтный конструктор
+  Sweep() = default;
+  /**
+   * @brief Конструктор с параметрами
+   * @param options Параметры перебора
+   */
+  explicit Sweep(const Options &options);
+  /**
+   * @brief Построить все конфигурации пространства поиска
+   * @param space Пространство поиска
+   */
+  static std::vector<Config> Grid(const SearchSpace &space);
+  /**
+   * @brief Выбрать случайные конфигурации пространства поиска
+   * @details Скорость обучения выбирается логарифмически равномерно между
+   * крайними значениями пространства
+   * @param space Пространство поиска
+   * @param count Количество конфигураций
+   * @param seed Зерно выбора
+   */
+  static std::vector<Config> Random(const SearchSpace &space,
+                                    std::size_t count, std::uint64_t seed);
+  /**
+   * @brief Обучить и протестировать конфигурации
+   * @param configs Конфигурации
+   * @param train Ридер с обучающей выборкой
+   * @param test Ридер с тестовой выборкой
+   * @return Результаты, отсортированные от лучшего к худшему
+   */
+  std::vector<Result> Run(const std::vector<Config> &configs,
+                          const ReaderEMNIST &train,
+                          const ReaderEMNIST &test) const;
+  /**
+   * @brief Сохранить таблицу результатов в csv
+   * @details В столбце network записан перцептрон, работавший на самом деле
+   * @param results Результаты
+   * @param path Путь до файла
+   */
+  static void SaveResults(const std::vector<Result> &results,
+                          const std::string &path);
+
+ private:
+  //! Параметры перебора
+  Options options_;
+};
+
+}  // namespace s21
@@ -1,7 +1,11 @@
 #include "graph_mse_window.h"
 
+#include <QSignalBlocker>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
+#include "../../model/profiler/tracer.h"
 #include "ui_graph_mse_window.h"
 
 namespace s21 {
@@ -18,6 +22,8 @@ std::vector<QColor> colours_ = {QColor("cyan"),     QColor("magenta"),
 GraphMseWindow::GraphMseWindow(QWidget *parent)
     : QMainWindow(parent),
       ui(new Ui::GraphMseWindow),
+      decimation_(Decimation::MinMax),
+      follow_(true),
       max_count_(0),
       max_value_(0.f) {
   for (auto &color : colours_) {
@@ -41,51 +47,141 @@ GraphMseWindow::GraphMseWindow(QWidget *parent)
   ui->graph->legend->setBrush(QColor(255, 255, 255, 150));
   ui->graph->setInteraction(QCP::iRangeDrag, true);
   ui->graph->setInteraction(QCP::iRangeZoom, true);
+  connect(ui->graph->xAxis,
+          QOverload<const QCPRange &>::of(&QCPAxis::rangeChanged), this,
+          &GraphMseWindow::UpdateVisible);
+  replot_timer_.start();
 }
 
 GraphMseWindow::~GraphMseWindow() { delete ui; }
 
-void GraphMseWindow::AddGraph(std::vector<double> mse) {
-  if (mse.empty()) {
-    return;
+void GraphMseWindow::BeginGraph() {
+  QColor color = colours_[series_.size() % colours_.size()];
+  auto *graph = ui->graph->addGraph();
+  graph->setLineStyle(QCPGraph::lsLine);
+  graph->setPen(QPen(color.lighter(200)));
+  graph->setBrush(QBrush(color));
+  graph->setName("MSE " + QString::number(series_.size() + 1));
+  series_.push_back({graph, LossCurve(plot_buckets), nullptr});
+  follow_ = true;
+  replot_timer_.start();
+  show();
+}
+
+void GraphMseWindow::AddMse(const double mse) {
+  if (series_.empty()) {
+    BeginGraph();
   }
-  if (ui->graph->graphCount() == static_cast<int>(colours_.size())) {
-    ClearGraph();
+  auto &series = series_.back();
+  series.mse.Add(mse);
+  max_count_ = std::max(max_count_, series.mse.Size());
+  max_value_ = std::max(max_value_, static_cast<float>(mse));
+  if (replot_timer_.elapsed() >= replot_interval_ms) {
+    Replot();
   }
-  QColor color = colours_[ui->graph->graphCount()];
-  ui->graph->addGraph();
-  ui->graph->graph()->setLineStyle(QCPGraph::lsLine);
-  ui->graph->graph()->setPen(QPen(color.lighter(200)));
-  ui->graph->graph()->setBrush(QBrush(color));
-  auto every = static_cast<std::size_t>(sqrt(static_cast<double>(mse.size())));
-  if (mse.size() > 4lu) {
-    every *= 2lu;
+}
+
+void GraphMseWindow::SetValidationMse(const std::vector<std::size_t> &steps,
+                                      const std::vector<double> &mse) {
+  if (series_.empty() || steps.empty()) {
+    return;
+  }
+  auto &series = series_.back();
+  if (series.validation == nullptr) {
+    series.validation = ui->graph->addGraph();
+    series.validation->setLineStyle(QCPGraph::lsLine);
+    series.validation->setScatterStyle(
+        QCPScatterStyle(QCPScatterStyle::ssCircle, 6));
+    series.validation->setPen(
+        QPen(series.graph->brush().color().darker(200), 2));
+    series.validation->setName("Validation " +
+                               QString::number(series_.size()));
   }
-  std::size_t new_size = mse.size() / every;
-  QVector<QCPGraphData> graphData(static_cast<QVector<QCPGraphData>::size_type>(
-      new_size == 0 ? mse.size() : new_size));
-  double mse_value = 0.f;
+  const auto count = std::min(steps.size(), mse.size());
+  QVector<QCPGraphData> graphData(
+      static_cast<QVector<QCPGraphData>::size_type>(count));
   for (int64_t i = 0; i < graphData.size(); ++i) {
-    graphData[i].key = static_cast<double>(i * every);
-    double value = 0;
-    for (std::size_t index = i * every; index < (i + 1) * every; ++index) {
-      value += mse[index];
-    }
-    mse_value += value;
-    graphData[i].value = value / static_cast<double>(every);
+    graphData[i].key = static_cast<double>(steps[static_cast<std::size_t>(i)]);
+    graphData[i].value = mse[static_cast<std::size_t>(i)];
     max_value_ = std::max(max_value_, static_cast<float>(graphData[i].value));
   }
-  mse_value /= static_cast<double>(mse.size());
-  ui->graph->graph()->data()->set(graphData);
-  max_count_ = std::max(max_count_, mse.size());
-  ui->graph->xAxis->setRange(0, static_cast<double>(max_count_));
-  ui->graph->yAxis->setRange(0, max_value_);
+  series.validation->data()->set(graphData, true);
+}
+
+void GraphMseWindow::EndGraph() {
+  if (series_.empty()) {
+    return;
+  }
+  const auto &series = series_.back();
+  if (series.mse.Size() != 0) {
+    series.graph->setName("MSE " + QString::number(series_.size()) + " - " +
+                          QString::number(series.mse.Mean(), 'f', 4));
+  }
+  Replot();
+}
+
+void GraphMseWindow::ClearGraph() {
+  series_.clear();
+  ui->graph->clearGraphs();
+  max_count_ = 0;
+  max_value_ = 0.f;
   ui->graph->replot();
-  ui->graph->graph()->setName("MSE " +
-                              QString::number(ui->graph->graphCount()) + " - " +
-                              QString::number(mse_value, 'f', 4));
 }
 
-void GraphMseWindow::ClearGraph() { ui->graph->clearGraphs(); }
+void GraphMseWindow::SetDecimation(const Decimation decimation) {
+  decimation_ = decimation;
+  UpdateVisible(ui->graph->xAxis->range());
+  ui->graph->replot();
+}
+
+void GraphMseWindow::on_lttb_check_box_toggled(const bool checked) {
+  SetDecimation(checked ? Decimation::Lttb : Decimation::MinMax);
+}
+
+void GraphMseWindow::on_graph_mousePress(QMouseEvent *) { follow_ = false; }
+
+void GraphMseWindow::on_graph_mouseWheel(QWheelEvent *) { follow_ = false; }
+
+void GraphMseWindow::on_graph_mouseDoubleClick(QMouseEvent *) {
+  follow_ = true;
+  Replot();
+}
+
+void GraphMseWindow::UpdateVisible(const QCPRange &) {
+  for (auto &series : series_) {
+    UpdateSeries(series);
+  }
+}
+
+void GraphMseWindow::UpdateSeries(Series &series) {
+  const auto range = ui->graph->xAxis->range();
+  const double begin = std::floor(range.lower) - 1.,
+               end = std::ceil(range.upper) + 2.;
+  const auto width =
+      static_cast<std::size_t>(std::max(ui->graph->axisRect()->width(), 1));
+  const auto points =
+      decimation_ == Decimation::Lttb
+          ? DecimateLttb(series.mse, begin, end, 2 * width)
+          : DecimateMinMax(series.mse, begin, end, width);
+  QVector<QCPGraphData> graphData(
+      static_cast<QVector<QCPGraphData>::size_type>(points.size()));
+  for (int64_t i = 0; i < graphData.size(); ++i) {
+    graphData[i].key = points[static_cast<std::size_t>(i)].key;
+    graphData[i].value = points[static_cast<std::size_t>(i)].value;
+  }
+  series.graph->data()->set(graphData, true);
+}
+
+void GraphMseWindow::Replot() {
+  S21_TRACE_SCOPE("GraphMseWindow::Replot");
+  if (follow_) {
+    const QSignalBlocker blocker(ui->graph->xAxis);
+    ui->graph->xAxis->setRange(0, static_cast<double>(max_count_));
+    ui->graph->yAxis->setRange(0, max_value_);
+  }
+  UpdateVisible(ui->graph->xAxis->range());
+  ui->graph->replot(QCustomPlot::rpImmediateRefresh);
+  replot_timer_.restart();
+}
 
 }  // namespace s21
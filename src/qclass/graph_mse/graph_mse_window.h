@@ -1,12 +1,21 @@
 #pragma once
 
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QMainWindow>
+#include <vector>
+
+#include "model/metrics/decimation.h"
 
 namespace Ui {
 class GraphMseWindow;
 }
 
+class QCPGraph;
+class QCPRange;
+class QMouseEvent;
+class QWheelEvent;
+
 namespace s21 {
 
 //! Класс окна графика средней квадратичной ошибки
@@ -14,6 +23,12 @@ class GraphMseWindow : public QMainWindow {
   Q_OBJECT
 
  public:
+  //! Способ прореживания графика
+  enum class Decimation { MinMax, Lttb };
+  //! Минимальный интервал перерисовки во время обучения
+  static constexpr qint64 replot_interval_ms = 50;
+  //! Количество корзин сводки ошибок одного графика
+  static constexpr std::size_t plot_buckets = 1 << 14;
   /**
    * @brief Дефолтный конструктор
    * @param parent Указатель на родителя
@@ -21,17 +36,64 @@ class GraphMseWindow : public QMainWindow {
   explicit GraphMseWindow(QWidget *parent = nullptr);
   //! Дефолтный деструктор
   ~GraphMseWindow() override;
+  //! Начать новый график ошибки
+  void BeginGraph();
   /**
-   * @brief Добавить график средней ошибки
-   * @param mse Вектор графика
+   * @brief Добавить ошибку очередного примера в текущий график
+   * @details Ошибка попадает в ограниченную сводку LossCurve, исходные
+   * ошибки не хранятся. Перерисовка происходит не чаще replot_interval_ms
+   * @param mse Ошибка
    */
-  void AddGraph(std::vector<double> mse);
+  void AddMse(double mse);
+  /**
+   * @brief Показать ошибку на валидационной выборке для текущего графика
+   * @details Точки валидации рисуются отдельной линией поверх ошибок
+   * обучения и не прореживаются
+   * @param steps Число обучающих примеров в каждой точке валидации
+   * @param mse Ошибка на валидационной выборке в каждой точке
+   */
+  void SetValidationMse(const std::vector<std::size_t> &steps,
+                        const std::vector<double> &mse);
+  //! Закончить текущий график и перерисовать окно
+  void EndGraph();
   //! Очистить график
   void ClearGraph();
+  //! Установить способ прореживания
+  void SetDecimation(Decimation decimation);
+
+ private slots:
+  //! Слот переключения прореживания LTTB
+  void on_lttb_check_box_toggled(bool checked);
+  //! Слот нажатия мыши, выключает слежение за концом графика
+  void on_graph_mousePress(QMouseEvent *);
+  //! Слот колеса мыши, выключает слежение за концом графика
+  void on_graph_mouseWheel(QWheelEvent *);
+  //! Слот двойного нажатия, возвращает слежение за концом графика
+  void on_graph_mouseDoubleClick(QMouseEvent *);
+  //! Слот смены видимого отрезка, прореживает графики под новый масштаб
+  void UpdateVisible(const QCPRange &);
 
  private:
+  //! График одного обучения
+  struct Series {
+    QCPGraph *graph;       //!< График
+    LossCurve mse;         //!< Сводка ошибок всех примеров
+    QCPGraph *validation;  //!< График валидации, если она проводилась
+  };
+  //! Прорядить видимую часть графика
+  void UpdateSeries(Series &series);
+  //! Перерисовать окно
+  void Replot();
   //! Указатель на UI
   Ui::GraphMseWindow *ui;
+  //! Графики
+  std::vector<Series> series_;
+  //! Время с последней перерисовки
+  QElapsedTimer replot_timer_;
+  //! Способ прореживания
+  Decimation decimation_;
+  //! Показывать ли весь график по мере добавления ошибок
+  bool follow_;
   //! Максимальное количество значений в графиках
   std::size_t max_count_;
   //! Максимальное значение ошибки в крафиках
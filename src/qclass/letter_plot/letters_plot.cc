@@ -5,29 +5,32 @@
 namespace s21 {
 
 LettersPlot::LettersPlot(QWidget *parent)
-    : QWidget{parent}, pixmap_(size()), last_click_() {
-  QPainter painter{&pixmap_};
-  painter.fillRect(rect(), Qt::white);
+    : QWidget{parent},
+      canvas_(size(), QImage::Format_Grayscale8),
+      preprocessor_(blur_radius),
+      last_click_() {
+  canvas_.fill(Qt::white);
 }
 
 void LettersPlot::DrawImage(QImage image) {
-  pixmap_.convertFromImage(image);
+  canvas_ = image.convertToFormat(QImage::Format_Grayscale8);
   resizeEvent(NULL);
   update();
 }
 
 void LettersPlot::paintEvent(QPaintEvent *) {
   QPainter painter(this);
-  painter.drawPixmap(0, 0, pixmap_);
+  painter.drawImage(0, 0, canvas_);
 }
 
 void LettersPlot::resizeEvent(QResizeEvent *) {
-  if (size() != pixmap_.size()) {
-    QPixmap newPixmap{size()};
-    QPainter painter{&newPixmap};
-    painter.fillRect(rect(), Qt::white);
-    painter.drawPixmap(0, 0, pixmap_.scaled(28, 28).scaled(size()));
-    pixmap_ = newPixmap;
+  if (size() != canvas_.size()) {
+    QImage newCanvas{size(), QImage::Format_Grayscale8};
+    newCanvas.fill(Qt::white);
+    QPainter painter{&newCanvas};
+    painter.drawImage(0, 0, canvas_.scaled(28, 28).scaled(size()));
+    painter.end();
+    canvas_ = newCanvas;
   }
 }
 
@@ -48,17 +51,16 @@ void LettersPlot::mouseMoveEvent(QMouseEvent *ev) {
 }
 
 void LettersPlot::ClearWindow() {
-  if (pixmap_.paintingActive()) {
+  if (canvas_.paintingActive()) {
     return;
   }
-  QPainter painter{&pixmap_};
-  painter.eraseRect(this->rect());
+  canvas_.fill(Qt::white);
   update();
   Controller::GetInstance().ForwardFeed(Matrix<float>(784, 1));
 }
 
 void LettersPlot::Draw(const QPoint &pos) {
-  QPainter painter{&pixmap_};
+  QPainter painter{&canvas_};
   painter.setRenderHint(QPainter::Antialiasing);
   QPen pen;
   pen.setWidth(28);
@@ -69,27 +71,10 @@ void LettersPlot::Draw(const QPoint &pos) {
 }
 
 void LettersPlot::SavePixels() {
-  QImage img;
-  img = pixmap_.toImage();
-  img = img.scaled(28, 28);
-  pixmap_.convertFromImage(img.scaled(pixmap_.size()));
-
-  QPixmap pxDst(img.size());
-  pxDst.fill(Qt::transparent);
-  {
-    QPainter painter(&pxDst);
-    qt_blurImage(&painter, img, 4, true, false);
-  }
-
-  Matrix<float> pixels(784, 1);
-  auto pixels_image = pxDst.toImage();
-  for (int i = 0, index = 0; i < pixels_image.size().width(); ++i) {
-    for (int j = 0; j < pixels_image.size().height(); ++j, ++index) {
-      pixels(index, 0) =
-          (static_cast<float>(pixels_image.pixelColor(i, j).black()) / 255.f);
-    }
-  }
-  Controller::GetInstance().ForwardFeed(pixels);
+  Controller::GetInstance().ForwardFeed(preprocessor_.Process(
+      canvas_.constBits(), static_cast<std::size_t>(canvas_.width()),
+      static_cast<std::size_t>(canvas_.height()),
+      static_cast<std::size_t>(canvas_.bytesPerLine())));
 }
 
 }  // namespace s21
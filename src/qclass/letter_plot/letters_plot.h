@@ -4,12 +4,7 @@
 #include <QtWidgets>
 #include <iostream>
 
-QT_BEGIN_NAMESPACE
-extern Q_WIDGETS_EXPORT void qt_blurImage(QPainter *p, QImage &blurImage,
-                                          qreal radius, bool quality,
-                                          bool alphaOnly, int transposed = 0);
-
-QT_END_NAMESPACE
+#include "model/preprocessor/image_preprocessor.h"
 
 namespace Ui {
 class LettersPlot;
@@ -33,8 +28,12 @@ class LettersPlot : public QWidget {
   void DrawImage(QImage image);
 
  private:
-  //! Рисунок
-  QPixmap pixmap_;
+  //! Радиус размытия рисунка перед подачей в перцептрон
+  static constexpr float blur_radius = 4.f;
+  //! Рисунок в оттенках серого
+  QImage canvas_;
+  //! Подготовка рисунка к подаче в перцептрон
+  ImagePreprocessor preprocessor_;
   //! Последняя нажатая клавиша
   Qt::MouseButton last_click_;
   /**
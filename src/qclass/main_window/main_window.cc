@@ -1,9 +1,12 @@
 #include "main_window.h"
 
+#include <QCloseEvent>
 #include <QFileDialog>
 #include <QMessageBox>
+#include <cmath>
 #include <functional>
 #include <map>
+#include <optional>
 
 #include "../../controller/controller.h"
 #include "qclass/settings/settings.h"
@@ -14,17 +17,35 @@ namespace s21 {
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
       graph_window_(new GraphMseWindow(this)),
-      ui_(new Ui::MainWindow) {
+      ui_(new Ui::MainWindow),
+      learning_(false),
+      close_requested_(false) {
   ui_->setupUi(this);
   initTableAnswers();
 }
 
 MainWindow::~MainWindow() { delete ui_; }
 
-void MainWindow::AddGraphMse(const std::vector<double> &mse_vector) {
-  graph_window_->AddGraph(mse_vector);
+void MainWindow::BeginGraphMse() { graph_window_->BeginGraph(); }
+
+void MainWindow::AddMse(const double mse) { graph_window_->AddMse(mse); }
+
+void MainWindow::SetValidationMse(const std::vector<std::size_t> &steps,
+                                  const std::vector<double> &mse) {
+  graph_window_->SetValidationMse(steps, mse);
+}
+
+void MainWindow::EndGraphMse() { graph_window_->EndGraph(); }
+
+void MainWindow::SetLearning(const bool learning) {
+  learning_ = learning;
+  ui_->menuLearn->setEnabled(!learning);
+  ui_->menuNetwork->setEnabled(!learning);
+  ui_->statusbar->showMessage(learning ? "Идет обучение" : "");
 }
 
+bool MainWindow::IsCloseRequested() const { return close_requested_; }
+
 void MainWindow::UpdateLettersAnswer(const Matrix<float> &answers) {
   std::map<float, char, std::greater<>> letters_proc;
   for (std::size_t index = 0; index < answers.GetRows(); ++index) {
@@ -38,6 +59,15 @@ void MainWindow::UpdateLettersAnswer(const Matrix<float> &answers) {
   }
 }
 
+void MainWindow::ShowInferenceLatency(const Matrix<float> &,
+                                      const double latency_ms) {
+  const auto latency = Controller::GetInstance().GetInferenceLatency();
+  ui_->statusbar->showMessage(
+      "Распознавание: " + QString::number(latency_ms, 'f', 3) +
+      " мс (среднее " + QString::number(latency.average_ms, 'f', 3) +
+      " мс, пропущено " + QString::number(latency.dropped) + ")");
+}
+
 void MainWindow::initTableAnswers() {
   ui_->tableAnswers->setColumnWidth(0, 20);
   ui_->tableAnswers->setColumnWidth(1, 67);
@@ -57,14 +87,29 @@ void MainWindow::clearTableAnswers() {
   }
 }
 
-void MainWindow::closeEvent(QCloseEvent *) {
-  delete graph_window_;
-  graph_window_ = nullptr;
+void MainWindow::closeEvent(QCloseEvent *event) {
+  if (learning_) {
+    close_requested_ = true;
+    ui_->statusbar->showMessage("Обучение прерывается");
+    event->ignore();
+    return;
+  }
+  graph_window_->close();
+  event->accept();
+}
+
+bool MainWindow::CloseIfRequested() {
+  if (!close_requested_) {
+    return false;
+  }
+  close();
+  return true;
 }
 
 void MainWindow::on_test_action_triggered() {
-  QString path = QFileDialog::getOpenFileName(this, tr("Open File"), ".",
-                                              tr("Table files (*.csv)"));
+  QString path = QFileDialog::getOpenFileName(
+      this, tr("Open File"), ".",
+      tr("Table files (*.csv);;IDX files (*images-idx3-ubyte*)"));
   if (path.isEmpty()) {
     return;
   }
@@ -83,24 +128,186 @@ void MainWindow::on_test_action_triggered() {
 }
 
 void MainWindow::on_learn_action_triggered() {
-  QString path = QFileDialog::getOpenFileName(this, tr("Open File"), ".",
-                                              tr("Table files (*.csv)"));
+  QString path = QFileDialog::getOpenFileName(
+      this, tr("Open File"), ".",
+      tr("Table files (*.csv);;IDX files (*images-idx3-ubyte*)"));
   if (path.isEmpty()) {
     return;
   }
+  QString validation_path;
+  if (Controller::GetInstance().IsValidation()) {
+    validation_path = QFileDialog::getOpenFileName(
+        this, tr("Open Validation File"), ".",
+        tr("Table files (*.csv);;IDX files (*images-idx3-ubyte*)"));
+  }
   std::clock_t start = clock();
-  Controller::GetInstance().Learn(path.toStdString());
-  QMessageBox::information(
-      this, "Внимание",
-      "Обучение закончилось!\nОбучение длилось: " +
-          QString::number(static_cast<double>(clock() - start) /
-                              static_cast<double>(CLOCKS_PER_SEC),
-                          'f', 2) +
-          " sec");
+  auto output = Controller::GetInstance().Learn(
+      path.toStdString(), validation_path.toStdString());
+  if (CloseIfRequested()) {
+    return;
+  }
+  QString message = "Обучение закончилось!\nОбучение длилось: " +
+                    QString::number(static_cast<double>(clock() - start) /
+                                        static_cast<double>(CLOCKS_PER_SEC),
+                                    'f', 2) +
+                    " sec";
+  if (output.fit) {
+    message += "\n\nВалидация (" +
+               QString::number(output.fit->validation_mse.size()) +
+               " проверок):";
+    for (std::size_t index = 0; index < output.fit->validation_mse.size();
+         ++index) {
+      message += "\n" + QString::number(index + 1) + ": MSE " +
+                 QString::number(output.fit->validation_mse[index], 'f', 4) +
+                 (index == output.fit->best ? " (лучшая)" : "");
+    }
+    if (output.fit->stopped) {
+      message += "\nОбучение остановлено досрочно";
+    }
+  }
+  QMessageBox::information(this, "Внимание", message);
   graph_window_->show();
   graph_window_->update();
 }
 
+void MainWindow::on_cross_validation_action_triggered() {
+  QString path = QFileDialog::getOpenFileName(
+      this, tr("Open File"), ".",
+      tr("Table files (*.csv);;IDX files (*images-idx3-ubyte*)"));
+  if (path.isEmpty()) {
+    return;
+  }
+  std::optional<Model::CrossValidationOutput> cross_validation;
+  try {
+    cross_validation =
+        Controller::GetInstance().CrossValidation(path.toStdString());
+  } catch (const std::exception &error) {
+    QMessageBox::warning(this, "Внимание", error.what());
+    return;
+  }
+  if (!cross_validation) {
+    return;
+  }
+  QString message =
+      "Кросс-валидация (" + QString::number(cross_validation->folds.size()) +
+      " блоков, " + QString::number(cross_validation->time_sec, 'f', 2) +
+      " sec):";
+  for (std::size_t fold = 0; fold < cross_validation->folds.size(); ++fold) {
+    message += "\nБлок " + QString::number(fold + 1) + ": accuracy " +
+               QString::number(
+                   cross_validation->folds[fold].average_accuracy * 100.f,
+                   'f', 2) +
+               "%, F-Measure " +
+               QString::number(
+                   cross_validation->folds[fold].f_measure * 100.f, 'f', 2) +
+               "%";
+  }
+  message += "\nAverage accuracy: " +
+             QString::number(
+                 cross_validation->mean.average_accuracy * 100.f, 'f', 2) +
+             "% ± " +
+             QString::number(
+                 std::sqrt(cross_validation->variance.average_accuracy) *
+                     100.f,
+                 'f', 2) +
+             "%\nF-Measure: " +
+             QString::number(cross_validation->mean.f_measure * 100.f, 'f',
+                             2) +
+             "% ± " +
+             QString::number(
+                 std::sqrt(cross_validation->variance.f_measure) * 100.f,
+                 'f', 2) +
+             "%";
+  QMessageBox::information(this, "Внимание", message);
+}
+
+void MainWindow::on_resume_action_triggered() {
+  QString checkpoint_path = QFileDialog::getOpenFileName(
+      this, tr("Open Checkpoint"), ".", tr("Checkpoint files (*.ckpt)"));
+  if (checkpoint_path.isEmpty()) {
+    return;
+  }
+  QString path = QFileDialog::getOpenFileName(
+      this, tr("Open File"), ".",
+      tr("Table files (*.csv);;IDX files (*images-idx3-ubyte*)"));
+  if (path.isEmpty()) {
+    return;
+  }
+  try {
+    Controller::GetInstance().Resume(checkpoint_path.toStdString(),
+                                     path.toStdString());
+  } catch (const std::exception &error) {
+    if (!CloseIfRequested()) {
+      QMessageBox::warning(this, "Внимание", error.what());
+    }
+    return;
+  }
+  if (CloseIfRequested()) {
+    return;
+  }
+  QMessageBox::information(this, "Внимание", "Обучение закончилось!");
+  graph_window_->show();
+  graph_window_->update();
+}
+
+void MainWindow::on_checkpoint_action_triggered() {
+  QString path = QFileDialog::getSaveFileName(
+      this, tr("Save Checkpoints"), ".", tr("Checkpoint files (*.ckpt)"));
+  Controller::GetInstance().SetCheckpoint(path.toStdString());
+  ui_->statusbar->showMessage(path.isEmpty()
+                                  ? "Контрольные точки выключены"
+                                  : "Контрольные точки: " + path);
+}
+
+void MainWindow::on_profile_action_triggered() {
+  const auto profile = Controller::GetInstance().GetProfile();
+  QString message;
+  if (!Profiler::enabled) {
+    message = "Таймеры фаз выключены опцией сборки S21_PROFILE\n";
+  }
+  for (std::size_t index = 0; index < Profiler::count_phases; ++index) {
+    const auto &phase = profile.phases[index];
+    message += QString(Profiler::GetPhaseName(
+                   static_cast<Profiler::Phase>(index))) +
+               ": " + QString::number(phase.seconds, 'f', 3) + " сек, " +
+               QString::number(phase.calls) + " замеров\n";
+  }
+  message += "Примеров в секунду: " +
+             QString::number(profile.samples_per_sec, 'f', 1) +
+             "\nВыделений памяти матриц: " +
+             QString::number(profile.allocations) +
+             "\nПик памяти матриц: " +
+             QString::number(static_cast<double>(profile.peak_bytes) /
+                                 (1 << 20),
+                             'f', 2) +
+             " МБ\nОтложенных сбросов арен: " +
+             QString::number(profile.skipped_resets);
+  QMessageBox::information(this, "Профиль", message);
+  Controller::GetInstance().ResetProfile();
+}
+
+void MainWindow::on_trace_action_toggled(bool checked) {
+  if (checked) {
+    Controller::GetInstance().StartTrace();
+    ui_->statusbar->showMessage("Идет запись трассировки");
+    return;
+  }
+  QString path = QFileDialog::getSaveFileName(
+      this, tr("Save Trace"), "trace.json", tr("Trace files (*.json)"));
+  ui_->statusbar->clearMessage();
+  if (path.isEmpty()) {
+    Controller::GetInstance().SaveTrace({});
+    return;
+  }
+  try {
+    Controller::GetInstance().SaveTrace(path.toStdString());
+  } catch (const std::exception &error) {
+    QMessageBox::warning(this, "Внимание", error.what());
+    return;
+  }
+  ui_->statusbar->showMessage("Трассировка: " + path);
+}
+
 void MainWindow::on_open_graph_action_triggered() { graph_window_->show(); }
 
 void MainWindow::on_settings_action_triggered() {
@@ -109,8 +316,8 @@ void MainWindow::on_settings_action_triggered() {
 }
 
 void MainWindow::on_load_network_action_triggered() {
-  QString path = QFileDialog::getOpenFileName(this, tr("Open Network"), ".",
-                                              tr("Net files (*.net)"));
+  QString path = QFileDialog::getOpenFileName(
+      this, tr("Open Network"), ".", tr("Net files (*.net *.bin)"));
   if (path.isEmpty()) {
     return;
   }
@@ -119,11 +326,16 @@ void MainWindow::on_load_network_action_triggered() {
 
 void MainWindow::on_save_network_action_triggered() {
   QString path = QFileDialog::getSaveFileName(
-      this, tr("Save Network"), "network.net", tr("Net files (*.net)"));
+      this, tr("Save Network"), "network.net",
+      tr("Net files (*.net);;Binary net files (*.bin)"));
   if (path.isEmpty()) {
     return;
   }
-  Controller::GetInstance().SaveWeights(path.toStdString());
+  if (path.endsWith(".bin")) {
+    Controller::GetInstance().SaveBinaryWeights(path.toStdString());
+  } else {
+    Controller::GetInstance().SaveWeights(path.toStdString());
+  }
 }
 
 void MainWindow::on_load_image_letter_action_triggered() {
@@ -133,15 +345,16 @@ void MainWindow::on_load_image_letter_action_triggered() {
     return;
   }
 
-  Matrix<float> pixels(784, 1);
-  auto pixels_image = QPixmap(path).scaled(28, 28).toImage();
-  for (int i = 0, index = 0; i < pixels_image.size().width(); ++i) {
-    for (int j = 0; j < pixels_image.size().height(); ++j, ++index) {
-      pixels(index, 0) = (pixels_image.pixelColor(i, j).black() / 255.f);
-    }
+  const QImage image =
+      QImage(path).convertToFormat(QImage::Format_Grayscale8);
+  if (image.isNull()) {
+    return;
   }
-  Controller::GetInstance().ForwardFeed(pixels);
-  ui_->widget->DrawImage(pixels_image);
+  Controller::GetInstance().ForwardFeed(image_preprocessor_.Process(
+      image.constBits(), static_cast<std::size_t>(image.width()),
+      static_cast<std::size_t>(image.height()),
+      static_cast<std::size_t>(image.bytesPerLine())));
+  ui_->widget->DrawImage(image);
 }
 
 }  // namespace s21
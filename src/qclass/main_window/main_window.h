@@ -2,6 +2,7 @@
 
 #include <QMainWindow>
 
+#include "model/preprocessor/image_preprocessor.h"
 #include "qclass/graph_mse/graph_mse_window.h"
 #include "third-party/matrix.h"
 
@@ -27,11 +28,35 @@ class MainWindow : public QMainWindow {
   //! Дефолтный деструктор
   ~MainWindow() override;
 
+  //! Начать новый график ошибок
+  void BeginGraphMse();
   /**
-   * @brief Добавить график ошибок
-   * @param mse_vector Вектор ошибок
+   * @brief Добавить ошибку очередного примера в график
+   * @param mse Ошибка
    */
-  void AddGraphMse(const std::vector<double> &mse_vector);
+  void AddMse(double mse);
+  /**
+   * @brief Показать ошибку на валидационной выборке в текущем графике
+   * @param steps Число обучающих примеров в каждой точке валидации
+   * @param mse Ошибка на валидационной выборке в каждой точке
+   */
+  void SetValidationMse(const std::vector<std::size_t> &steps,
+                        const std::vector<double> &mse);
+  //! Закончить график ошибок
+  void EndGraphMse();
+  /**
+   * @brief Переключить окно в режим обучения
+   * @details Во время обучения меню, меняющие модель, недоступны, а
+   * рисование и распознавание букв продолжают работать
+   * @param learning Идет ли обучение
+   */
+  void SetLearning(bool learning);
+  /**
+   * @brief Узнать, пытались ли закрыть окно во время обучения
+   * @details Обучение идет внутри слота окна, поэтому закрытие откладывается:
+   * обучение прерывается, и окно закрывается после выхода из него
+   */
+  bool IsCloseRequested() const;
 
   /**
    * @brief Обновить ответы
@@ -39,16 +64,33 @@ class MainWindow : public QMainWindow {
    */
   void UpdateLettersAnswer(const Matrix<float> &answers);
 
+  /**
+   * @brief Показать задержку распознавания в строке состояния
+   * @param answers Матрица ответов
+   * @param latency_ms Задержка распознавания в миллисекундах
+   */
+  void ShowInferenceLatency(const Matrix<float> &answers, double latency_ms);
+
   //! Очистить значения Таблички
   void clearTableAnswers();
 
  private slots:
-  //! Слот обработки закрытия окна
+  //! Слот обработки закрытия окна, во время обучения откладывает закрытие
   void closeEvent(QCloseEvent *) override;
   //! Слот нажатия кнопки "Тест"
   void on_test_action_triggered();
   //! Слот нажатия кнопки "Обучение"
   void on_learn_action_triggered();
+  //! Слот нажатия кнопки "Кросс-валидация"
+  void on_cross_validation_action_triggered();
+  //! Слот нажатия кнопки "Продолжить обучение"
+  void on_resume_action_triggered();
+  //! Слот нажатия кнопки "Контрольные точки"
+  void on_checkpoint_action_triggered();
+  //! Слот нажатия кнопки "Профиль"
+  void on_profile_action_triggered();
+  //! Слот переключения кнопки "Трассировка"
+  void on_trace_action_toggled(bool checked);
   //! Слот нажатия кнопки "График"
   void on_open_graph_action_triggered();
   //! Слот нажатия кнопки "Настройки"
@@ -63,10 +105,18 @@ class MainWindow : public QMainWindow {
  private:
   //! Инициализация таблички
   void initTableAnswers();
+  //! Закрыть окно, если это просили во время обучения
+  bool CloseIfRequested();
   //! Указатель на окно Графика
   GraphMseWindow *graph_window_;
+  //! Подготовка загруженных изображений к подаче в перцептрон
+  ImagePreprocessor image_preprocessor_;
   //! Указатель на UI
   Ui::MainWindow *ui_;
+  //! Идет ли обучение
+  bool learning_;
+  //! Пытались ли закрыть окно во время обучения
+  bool close_requested_;
 };
 
 }  // namespace s21
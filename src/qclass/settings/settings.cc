@@ -1,5 +1,9 @@
 #include "settings.h"
 
+#include <QStringList>
+#include <algorithm>
+#include <functional>
+
 #include "controller/controller.h"
 #include "ui_settings.h"
 
@@ -9,23 +13,55 @@ Settings::Settings(QWidget *parent) : QDialog(parent), ui(new Ui::Settings) {
   ui->setupUi(this);
   ui->layers_spin_box->setValue(Controller::GetInstance().GetCountLayers());
   ui->neirons_spin_box->setValue(Controller::GetInstance().GetCountNeurons());
+  const auto &hidden_layers = Controller::GetInstance().GetHiddenLayers();
+  if (std::adjacent_find(hidden_layers.begin(), hidden_layers.end(),
+                         std::not_equal_to<>()) != hidden_layers.end()) {
+    QStringList widths;
+    for (const auto neurons : hidden_layers) {
+      widths << QString::number(neurons);
+    }
+    ui->hidden_layers_line_edit->setText(widths.join(' '));
+  }
   ui->matrix_radio_button->setChecked(
       Controller::GetInstance().IsMatrixNetwork());
   ui->graph_radio_button->setChecked(
       Controller::GetInstance().IsGraphNetwork());
+  ui->static_radio_button->setChecked(
+      Controller::GetInstance().IsStaticNetwork());
   ui->epoch_spin_box->setValue(Controller::GetInstance().GetCountEpoch());
   ui->k_valid_spin_box->setValue(Controller::GetInstance().GetKValid());
   ui->learning_rate_double_spin_box->setValue(
       Controller::GetInstance().GetLearningRate());
   ui->part_test_horizontal_slider->setValue(
       Controller::GetInstance().GetTestSample() * 100.f);
+  ui->validation_check_box->setChecked(
+      Controller::GetInstance().IsValidation());
+  const auto validation = Controller::GetInstance().GetValidationOptions();
+  ui->period_spin_box->setValue(static_cast<int>(validation.period));
+  ui->patience_spin_box->setValue(static_cast<int>(validation.patience));
+  ui->min_delta_double_spin_box->setValue(validation.min_delta);
 }
 
 void Settings::on_buttonBox_accepted() {
-  Controller::GetInstance().SetCountLayers(ui->layers_spin_box->value());
-  Controller::GetInstance().SetCountNeurons(ui->neirons_spin_box->value());
+  std::vector<std::size_t> hidden_layers;
+  for (const auto &width : ui->hidden_layers_line_edit->text().split(
+           ' ', Qt::SkipEmptyParts)) {
+    bool ok = false;
+    const auto neurons = width.toULong(&ok);
+    if (ok && neurons != 0) {
+      hidden_layers.push_back(neurons);
+    }
+  }
+  if (hidden_layers.empty()) {
+    Controller::GetInstance().SetCountLayers(ui->layers_spin_box->value());
+    Controller::GetInstance().SetCountNeurons(ui->neirons_spin_box->value());
+  } else {
+    Controller::GetInstance().SetHiddenLayers(hidden_layers);
+  }
   if (ui->matrix_radio_button->isChecked()) {
     Controller::GetInstance().SetMatrixNetwork();
+  } else if (ui->static_radio_button->isChecked()) {
+    Controller::GetInstance().SetStaticNetwork();
   } else {
     Controller::GetInstance().SetGraphNetwork();
   }
@@ -35,6 +71,13 @@ void Settings::on_buttonBox_accepted() {
   Controller::GetInstance().SetTestSample(
       ui->part_test_horizontal_slider->value() / 100.f);
   Controller::GetInstance().SetKValid(ui->k_valid_spin_box->value());
+  Controller::GetInstance().SetValidation(
+      ui->validation_check_box->isChecked());
+  auto validation = Controller::GetInstance().GetValidationOptions();
+  validation.period = ui->period_spin_box->value();
+  validation.patience = ui->patience_spin_box->value();
+  validation.min_delta = ui->min_delta_double_spin_box->value();
+  Controller::GetInstance().SetValidationOptions(validation);
 }
 
 Settings::~Settings() { delete ui; }
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "../model/checkpoint/checkpoint.h"
+#include "test.h"
+
+namespace {
+const std::string path_weights = "sample/weight_for_test.net";
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string tmp_checkpoint_path = "tmp_checkpoint.ckpt";
+const std::string tmp_straight_path = "tmp_checkpoint_straight.net";
+const std::string tmp_resumed_path = "tmp_checkpoint_resumed.net";
+
+void TrainInterrupted(std::size_t period, std::size_t stop_after) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.LoadWeights(path_weights);
+  model.SetCountEpoch(3);
+  model.SetCheckpoint(tmp_checkpoint_path, period);
+  std::size_t steps = 0;
+  model.Train(reader, [&](double) { return ++steps < stop_after; });
+}
+}  // namespace
+
+TEST(Checkpoint, ResumeIsBitExact) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  {
+    ::s21::Model model;
+    model.LoadWeights(path_weights);
+    model.SetCountEpoch(3);
+    model.Train(reader);
+    model.SaveWeights(tmp_straight_path);
+  }
+  for (const auto &[period, stop_after] :
+       {std::pair<std::size_t, std::size_t>{30, 50},
+        std::pair<std::size_t, std::size_t>{0, 90},
+        std::pair<std::size_t, std::size_t>{25, 170}}) {
+    TrainInterrupted(period, stop_after);
+    ::s21::Model model;
+    model.Resume(tmp_checkpoint_path);
+    auto mse = model.Train(reader);
+    EXPECT_FALSE(mse.empty());
+    model.SaveWeights(tmp_resumed_path);
+    EXPECT_TRUE(test::CompareFiles(tmp_straight_path, tmp_resumed_path));
+  }
+  std::remove(tmp_checkpoint_path.c_str());
+  std::remove(tmp_straight_path.c_str());
+  std::remove(tmp_resumed_path.c_str());
+}
+
+TEST(Checkpoint, RejectsBadFile) {
+  {
+    std::ofstream file(tmp_checkpoint_path);
+    file << "2\n";
+  }
+  ::s21::Model model;
+  EXPECT_THROW(model.Resume(tmp_checkpoint_path), std::invalid_argument);
+  std::remove(tmp_checkpoint_path.c_str());
+}
+
+TEST(Checkpoint, RejectsForeignTopology) {
+  ::s21::Checkpoint checkpoint;
+  checkpoint.network = 1;
+  checkpoint.layers = {
+      {::s21::Matrix<float>(8, 10), ::s21::Matrix<float>(8, 1)},
+      {::s21::Matrix<float>(3, 8), ::s21::Matrix<float>(3, 1)}};
+  checkpoint.Save(tmp_checkpoint_path);
+  ::s21::Model model;
+  model.SetHiddenLayers({32, 16});
+  EXPECT_THROW(model.Resume(tmp_checkpoint_path), std::invalid_argument);
+  EXPECT_TRUE(model.IsMatrixNetwork());
+  EXPECT_EQ(model.GetHiddenLayers(), (std::vector<std::size_t>{32, 16}));
+  std::remove(tmp_checkpoint_path.c_str());
+}
+
+TEST(Checkpoint, KeepsAugmentationOptions) {
+  ::s21::Checkpoint checkpoint;
+  checkpoint.augmentation = true;
+  checkpoint.augmentation_options = {1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+  checkpoint.layers = {
+      {::s21::Matrix<float>(2, 784), ::s21::Matrix<float>(2, 1)},
+      {::s21::Matrix<float>(26, 2), ::s21::Matrix<float>(26, 1)}};
+  checkpoint.Save(tmp_checkpoint_path);
+  const auto loaded = ::s21::Checkpoint::Load(tmp_checkpoint_path);
+  const auto &options = loaded.augmentation_options;
+  EXPECT_TRUE(loaded.augmentation);
+  EXPECT_EQ(options.shift, 1.f);
+  EXPECT_EQ(options.rotation, 2.f);
+  EXPECT_EQ(options.shear, 3.f);
+  EXPECT_EQ(options.elastic_alpha, 4.f);
+  EXPECT_EQ(options.elastic_sigma, 5.f);
+  EXPECT_EQ(options.thickness, 6.f);
+  std::remove(tmp_checkpoint_path.c_str());
+}
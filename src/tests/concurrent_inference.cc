@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+
+#include "test.h"
+
+namespace {
+const std::string train_sample = "sample/train_for_test.csv";
+}  // namespace
+
+TEST(ConcurrentInference, CopyWeightsMatchesClone) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  for (std::size_t network = 0; network < 3; ++network) {
+    if (network == 1) {
+      model.SetGraphNetwork();
+    } else if (network == 2) {
+      model.SetStaticNetwork();
+    }
+    model.SetSeed(network + 1);
+    const auto target = model.GetPublishedNetwork().Acquire()->value->Clone();
+    model.Learn(reader);
+    ASSERT_TRUE(target->CopyWeightsFrom(
+        *model.GetPublishedNetwork().Acquire()->value));
+    const auto expected = model.ForwardFeed(reader[0].first);
+    const auto actual = target->ForwardFeed(reader[0].first);
+    for (std::size_t row = 0; row < expected.GetRows(); ++row) {
+      EXPECT_EQ(actual(row, 0), expected(row, 0));
+    }
+  }
+}
+
+TEST(ConcurrentInference, CopyWeightsRejectsMismatch) {
+  ::s21::Model model;
+  const auto matrix = model.GetPublishedNetwork().Acquire()->value->Clone();
+  model.SetGraphNetwork();
+  const auto graph = model.GetPublishedNetwork().Acquire()->value->Clone();
+  EXPECT_FALSE(matrix->CopyWeightsFrom(*graph));
+  EXPECT_FALSE(graph->CopyWeightsFrom(*matrix));
+  model.SetMatrixNetwork();
+  model.SetHiddenLayers({32});
+  const auto narrow = model.GetPublishedNetwork().Acquire()->value;
+  EXPECT_FALSE(matrix->CopyWeightsFrom(*narrow));
+}
+
+TEST(ConcurrentInference, SnapshotsDuringEpoch) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.SetSnapshotPeriod(10);
+  EXPECT_EQ(model.GetSnapshotPeriod(), 10);
+  const auto before = model.GetPublishedNetwork().GetVersion();
+  std::size_t observed = 0;
+  model.Learn(reader, [&](double) {
+    observed = model.GetPublishedNetwork().GetVersion();
+    return true;
+  });
+  EXPECT_GE(observed, before + reader.Size() / 10 - 1);
+  EXPECT_GE(model.GetPublishedNetwork().GetVersion(),
+            before + reader.Size() / 10);
+}
+
+TEST(ConcurrentInference, SnapshotBuffersAreReused) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.SetSnapshotPeriod(1);
+  const auto held = model.GetPublishedNetwork().Acquire()->value;
+  const auto expected = held->Clone()->ForwardFeed(reader[0].first);
+  std::set<const ::s21::BaseNetwork *> buffers;
+  model.Learn(reader, [&](double) {
+    buffers.insert(model.GetPublishedNetwork().Acquire()->value.get());
+    return true;
+  });
+  EXPECT_LE(buffers.size(), 3);
+  EXPECT_EQ(buffers.count(held.get()), 0);
+  const auto actual = held->Clone()->ForwardFeed(reader[0].first);
+  for (std::size_t row = 0; row < expected.GetRows(); ++row) {
+    EXPECT_EQ(actual(row, 0), expected(row, 0));
+  }
+}
+
+TEST(ConcurrentInference, InferenceWhileLearning) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.SetSnapshotPeriod(4);
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> answers{0};
+  auto infer = [&] {
+    ::s21::NetworkReplica replica(model.GetPublishedNetwork());
+    for (std::size_t index = 0; !stop; ++index) {
+      replica.Refresh();
+      const auto output =
+          replica.ForwardFeed(reader[index % reader.Size()].first);
+      EXPECT_EQ(output.GetRows(), ::s21::Model::outer_layer_size);
+      ++answers;
+    }
+  };
+  std::thread first(infer), second(infer);
+  const auto before = model.GetPublishedNetwork().GetVersion();
+  for (std::size_t epoch = 0; epoch < 3; ++epoch) {
+    model.Learn(reader);
+  }
+  while (answers < 10) {
+    std::this_thread::yield();
+  }
+  stop = true;
+  first.join();
+  second.join();
+  EXPECT_GE(model.GetPublishedNetwork().GetVersion(),
+            before + 3 * (reader.Size() / 4));
+}
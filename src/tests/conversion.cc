@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "test.h"
+
+namespace {
+const std::string path_weights = "sample/weight_for_test.net";
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string tmp_path = "tmp_conversion.net";
+}  // namespace
+
+TEST(Conversion, KeepsWeightsAcrossEngines) {
+  ::s21::Model model;
+  model.LoadWeights(path_weights);
+  model.SetGraphNetwork();
+  EXPECT_TRUE(model.IsGraphNetwork());
+  model.SaveWeights(tmp_path);
+  EXPECT_TRUE(test::CompareFiles(path_weights, tmp_path));
+  model.SetStaticNetwork();
+  EXPECT_FALSE(model.IsStaticNetwork());
+  EXPECT_TRUE(model.IsMatrixNetwork());
+  model.SaveWeights(tmp_path);
+  EXPECT_TRUE(test::CompareFiles(path_weights, tmp_path));
+  model.SetMatrixNetwork();
+  model.SaveWeights(tmp_path);
+  EXPECT_TRUE(test::CompareFiles(path_weights, tmp_path));
+  EXPECT_TRUE(::test::TestLetter(model, ::test::letter_r()));
+  std::remove(tmp_path.c_str());
+}
+
+TEST(Conversion, TrainedWeightsSurviveSwitch) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.SetHiddenLayers({48, 32});
+  model.Learn(reader);
+  const auto expected = model.ForwardFeed(reader[0].first);
+  model.SetGraphNetwork();
+  EXPECT_EQ(model.GetTopology(), (std::vector<std::size_t>{784, 48, 32, 26}));
+  const auto actual = model.ForwardFeed(reader[0].first);
+  for (std::size_t row = 0; row < expected.GetRows(); ++row) {
+    EXPECT_NEAR(actual(row, 0), expected(row, 0), 1e-5);
+  }
+}
+
+TEST(Conversion, RejectsBrokenMatrices) {
+  ::s21::BaseNetwork::LayerMatrices layers(2);
+  layers[0].first.Set(16, 784);
+  layers[0].second.Set(16, 1);
+  layers[1].first.Set(26, 8);
+  layers[1].second.Set(26, 1);
+  EXPECT_THROW(::s21::MatrixNetwork{layers}, std::invalid_argument);
+  EXPECT_THROW(::s21::GraphNetwork{layers}, std::invalid_argument);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "test.h"
+
+namespace {
+const std::string path_weights = "sample/weight_for_test.net";
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string tmp_path = "tmp_cross_validation.net";
+}  // namespace
+
+TEST(CrossValidation, FoldsAreIndependent) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  for (bool graph : {false, true}) {
+    ::s21::Model model;
+    graph ? model.SetGraphNetwork() : model.SetMatrixNetwork();
+    model.LoadWeights(path_weights);
+    model.SetKValid(4);
+    model.SetCountEpoch(2);
+    auto first = model.CrossValidation(reader);
+    model.SaveWeights(tmp_path);
+    EXPECT_TRUE(test::CompareFiles(path_weights, tmp_path));
+    ASSERT_EQ(first.folds.size(), 4);
+    double sum = 0;
+    for (const auto &fold : first.folds) {
+      EXPECT_GE(fold.average_accuracy, 0.);
+      EXPECT_LE(fold.average_accuracy, 1.);
+      sum += fold.average_accuracy;
+    }
+    EXPECT_NEAR(first.mean.average_accuracy, sum / 4, 1e-12);
+    EXPECT_GE(first.variance.average_accuracy, 0.);
+    auto second = model.CrossValidation(reader);
+    for (std::size_t fold = 0; fold < first.folds.size(); ++fold) {
+      EXPECT_EQ(first.folds[fold].average_accuracy,
+                second.folds[fold].average_accuracy);
+    }
+  }
+  std::remove(tmp_path.c_str());
+}
+
+TEST(CrossValidation, NeedsTwoFolds) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.SetKValid(1);
+  EXPECT_THROW(model.CrossValidation(reader), std::invalid_argument);
+  model.SetKValid(reader.Size() + 1);
+  EXPECT_THROW(model.CrossValidation(reader), std::invalid_argument);
+}
+
+TEST(CrossValidation, MoreFoldsThanThreads) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.LoadWeights(path_weights);
+  const std::size_t k_valid = std::min<std::size_t>(
+      2 * std::max(std::thread::hardware_concurrency(), 1u) + 1,
+      reader.Size());
+  model.SetKValid(k_valid);
+  model.SetCountEpoch(1);
+  const auto output = model.CrossValidation(reader);
+  ASSERT_EQ(output.folds.size(), k_valid);
+  for (const auto &fold : output.folds) {
+    EXPECT_GT(fold.time_sec, 0.);
+  }
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include "test.h"
+
+namespace {
+const std::string path_weights = "sample/weight_for_test.net";
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string tmp_first_path = "tmp_loader_first.net";
+const std::string tmp_second_path = "tmp_loader_second.net";
+
+std::vector<std::size_t> CollectAnswers(::s21::DataLoader &loader) {
+  std::vector<std::size_t> answers;
+  while (const auto *batch = loader.Next()) {
+    EXPECT_LE(batch->size, 8);
+    answers.insert(answers.end(), batch->answers.begin(),
+                   batch->answers.begin() + batch->size);
+  }
+  return answers;
+}
+}  // namespace
+
+TEST(DataLoader, PermutationIsDeterministic) {
+  auto first = ::s21::DataLoader::Permutation(100, 7, 3);
+  EXPECT_EQ(first, ::s21::DataLoader::Permutation(100, 7, 3));
+  EXPECT_NE(first, ::s21::DataLoader::Permutation(100, 7, 4));
+  EXPECT_NE(first, ::s21::DataLoader::Permutation(100, 8, 3));
+  std::sort(first.begin(), first.end());
+  for (std::size_t index = 0; index < first.size(); ++index) {
+    EXPECT_EQ(first[index], index);
+  }
+}
+
+TEST(DataLoader, EpochCoversSample) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  std::vector<std::size_t> expected;
+  for (std::size_t index = 0; index < reader.Size(); ++index) {
+    expected.push_back(reader[index].second);
+  }
+  ::s21::DataLoader loader(reader, 8, 7);
+  for (std::size_t epoch = 0; epoch < 3; ++epoch) {
+    loader.StartEpoch(epoch);
+    auto answers = CollectAnswers(loader);
+    std::sort(answers.begin(), answers.end());
+    auto sorted = expected;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(answers, sorted);
+  }
+  ::s21::DataLoader ordered(reader, 8, 7, false);
+  ordered.StartEpoch(0, 5);
+  EXPECT_EQ(CollectAnswers(ordered),
+            std::vector<std::size_t>(expected.begin() + 5, expected.end()));
+}
+
+TEST(DataLoader, SameSeedSameWeights) {
+  ::s21::ReaderEMNIST train(train_sample);
+  for (const auto &path : {tmp_first_path, tmp_second_path}) {
+    ::s21::Model model;
+    model.LoadWeights(path_weights);
+    model.SetSeed(21);
+    model.Learn(train);
+    model.Learn(train);
+    model.SaveWeights(path);
+  }
+  EXPECT_TRUE(::test::CompareFiles(tmp_first_path, tmp_second_path));
+  std::remove(tmp_first_path.c_str());
+  std::remove(tmp_second_path.c_str());
+}
+
+TEST(DataLoader, AugmentationIsReproducible) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  const auto &source = reader[0].first;
+  ::s21::Augmentation augmentation({}, 5);
+  ::s21::Matrix<float> first(784, 1), second(784, 1), other(784, 1);
+  augmentation.Apply(source, first, ::s21::Augmentation::Key(1, 0));
+  augmentation.Apply(source, second, ::s21::Augmentation::Key(1, 0));
+  augmentation.Apply(source, other, ::s21::Augmentation::Key(2, 0));
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, other);
+  EXPECT_NE(first, source);
+  ::s21::Augmentation identity({0.f, 0.f, 0.f, 0.f, 0.f, 0.f}, 5);
+  identity.Apply(source, first, 1);
+  EXPECT_EQ(first, source);
+}
+
+TEST(DataLoader, AugmentationIndependentOfWorkers) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Augmentation augmentation({}, 5);
+  std::vector<std::vector<float>> results;
+  for (std::size_t workers : {1lu, 3lu}) {
+    ::s21::DataLoader loader(reader, 8, 7, true, workers);
+    loader.SetAugmentation(&augmentation);
+    loader.StartEpoch(2);
+    std::vector<float> values;
+    while (const auto *batch = loader.Next()) {
+      for (std::size_t index = 0; index < batch->size; ++index) {
+        const auto &sensors = batch->sensors[index];
+        values.insert(values.end(), &sensors(0, 0), &sensors(0, 0) + 784);
+      }
+    }
+    EXPECT_EQ(values.size(), reader.Size() * 784);
+    results.push_back(std::move(values));
+  }
+  EXPECT_EQ(results[0], results[1]);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "../model/loader/random.h"
+#include "../model/metrics/decimation.h"
+#include "test.h"
+
+namespace {
+std::vector<float> Noise(const std::size_t count) {
+  std::vector<float> values(count);
+  std::uint64_t state = 11;
+  for (auto &value : values) {
+    value = ::s21::UnitFloat(state = ::s21::SplitMix(state));
+  }
+  return values;
+}
+
+void ExpectOrdered(const std::vector<::s21::PlotPoint> &points,
+                   const std::vector<float> &values) {
+  for (std::size_t index = 0; index < points.size(); ++index) {
+    if (index != 0) {
+      EXPECT_LT(points[index - 1].key, points[index].key);
+    }
+    EXPECT_EQ(points[index].value,
+              values[static_cast<std::size_t>(points[index].key)]);
+  }
+}
+}  // namespace
+
+TEST(Decimation, SmallRangeIsCopied) {
+  const auto values = Noise(100);
+  for (const auto &points : {::s21::DecimateMinMax(values, 10, 60, 100),
+                             ::s21::DecimateLttb(values, 10, 60, 100)}) {
+    ASSERT_EQ(points.size(), 50);
+    EXPECT_EQ(points.front().key, 10.);
+    ExpectOrdered(points, values);
+  }
+}
+
+TEST(Decimation, MinMaxKeepsExtremes) {
+  auto values = Noise(1000000);
+  values[123457] = 5.f;
+  values[876543] = -5.f;
+  const auto points = ::s21::DecimateMinMax(values, 0, values.size(), 800);
+  EXPECT_LE(points.size(), 1600);
+  EXPECT_GE(points.size(), 800);
+  ExpectOrdered(points, values);
+  const auto [min, max] = std::minmax_element(
+      points.begin(), points.end(),
+      [](const ::s21::PlotPoint &left, const ::s21::PlotPoint &right) {
+        return left.value < right.value;
+      });
+  EXPECT_EQ(max->key, 123457.);
+  EXPECT_EQ(min->key, 876543.);
+}
+
+TEST(Decimation, LttbKeepsEndsAndSpike) {
+  auto values = Noise(100000);
+  values[50000] = 10.f;
+  const auto points = ::s21::DecimateLttb(values, 1000, 99000, 500);
+  ASSERT_EQ(points.size(), 500);
+  EXPECT_EQ(points.front().key, 1000.);
+  EXPECT_EQ(points.back().key, 98999.);
+  ExpectOrdered(points, values);
+  EXPECT_TRUE(std::any_of(points.begin(), points.end(),
+                          [](const ::s21::PlotPoint &point) {
+                            return point.key == 50000.;
+                          }));
+}
+
+TEST(Decimation, RangeIsClamped) {
+  const auto values = Noise(10);
+  EXPECT_EQ(::s21::DecimateMinMax(values, 5, 100, 1).size(), 2);
+  EXPECT_TRUE(::s21::DecimateLttb(values, 20, 30, 3).empty());
+}
+
+TEST(Decimation, CurveMatchesSamples) {
+  const auto values = Noise(50);
+  ::s21::LossCurve curve(64);
+  for (const float value : values) {
+    curve.Add(value);
+  }
+  const auto copied = ::s21::DecimateLttb(curve, 10., 60., 100);
+  ASSERT_EQ(copied.size(), 40);
+  EXPECT_EQ(copied.front().key, 10.);
+  ExpectOrdered(copied, values);
+  ExpectOrdered(::s21::DecimateMinMax(curve, 0., 50., 8), values);
+}
+
+TEST(Decimation, CurveKeepsExtremesWithinBound) {
+  auto values = Noise(1000000);
+  values[123457] = 5.f;
+  values[876543] = -5.f;
+  ::s21::LossCurve curve(1 << 12);
+  for (const float value : values) {
+    curve.Add(value);
+  }
+  EXPECT_LE(curve.GetBuckets().size(), 1 << 12);
+  const auto points = ::s21::DecimateMinMax(curve, 0., 1e6, 800);
+  EXPECT_LE(points.size(), 1600);
+  EXPECT_GE(points.size(), 800);
+  ExpectOrdered(points, values);
+  const auto [min, max] = std::minmax_element(
+      points.begin(), points.end(),
+      [](const ::s21::PlotPoint &left, const ::s21::PlotPoint &right) {
+        return left.value < right.value;
+      });
+  EXPECT_EQ(max->key, 123457.);
+  EXPECT_EQ(min->key, 876543.);
+
+  const auto zoomed = ::s21::DecimateMinMax(curve, 123000., 124000., 800);
+  EXPECT_LE(zoomed.size(), 2 * 6);
+  ExpectOrdered(zoomed, values);
+  EXPECT_TRUE(std::any_of(zoomed.begin(), zoomed.end(),
+                          [](const ::s21::PlotPoint &point) {
+                            return point.key == 123457.;
+                          }));
+  const auto lttb = ::s21::DecimateLttb(curve, 0., 1e6, 500);
+  ASSERT_EQ(lttb.size(), 500);
+  EXPECT_LT(lttb.front().key, curve.GetBucketWidth());
+  EXPECT_GT(lttb.back().key, 1e6 - curve.GetBucketWidth());
+  EXPECT_TRUE(::s21::DecimateMinMax(curve, 2e6, 3e6, 10).empty());
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "test.h"
+
+namespace {
+const std::string path_weights = "sample/weight_for_test.net";
+const std::string train_sample = "sample/train_for_test.csv";
+
+void ExpectEqual(const ::s21::Matrix<float> &left,
+                 const ::s21::Matrix<float> &right) {
+  ASSERT_EQ(left.GetRows(), right.GetRows());
+  for (std::size_t row = 0; row < left.GetRows(); ++row) {
+    EXPECT_EQ(left(row, 0), right(row, 0));
+  }
+}
+
+void Train(::s21::BaseNetwork &network, const ::s21::ReaderEMNIST &reader) {
+  for (std::size_t index = 0; index < reader.Size(); ++index) {
+    network.Learn(reader[index].first, reader[index].second, 0.1f);
+  }
+}
+}  // namespace
+
+TEST(GraphClone, CopyIsIndependent) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::GraphNetwork original({784, 64, 64, 26});
+  original.LoadWeights(path_weights);
+  const auto sensors = reader[0].first;
+  const auto before = original.ForwardFeed(sensors);
+  ::s21::GraphNetwork copy(original);
+  auto clone = original.Clone();
+  Train(original, reader);
+  ExpectEqual(copy.ForwardFeed(sensors), before);
+  ExpectEqual(clone->ForwardFeed(sensors), before);
+  Train(copy, reader);
+  ExpectEqual(copy.ForwardFeed(sensors), original.ForwardFeed(sensors));
+}
+
+TEST(GraphClone, AssignReusesOrRebuilds) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::GraphNetwork source({784, 32, 26});
+  ::s21::GraphNetwork same({784, 32, 26});
+  ::s21::GraphNetwork other({784, 16, 16, 26});
+  same = source;
+  other = source;
+  const auto expected = source.ForwardFeed(reader[1].first);
+  ExpectEqual(same.ForwardFeed(reader[1].first), expected);
+  ExpectEqual(other.ForwardFeed(reader[1].first), expected);
+  Train(source, reader);
+  ExpectEqual(other.ForwardFeed(reader[1].first), expected);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "test.h"
+
+namespace {
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string path_weights = "sample/weight_for_test.net";
+}  // namespace
+
+TEST(HotSwap, OldVersionOutlivesPublish) {
+  ::s21::Published<int> published;
+  EXPECT_EQ(published.Acquire(), nullptr);
+  published.Publish(std::make_unique<const int>(1));
+  const auto first = published.Acquire();
+  published.Publish(std::make_unique<const int>(2));
+  EXPECT_EQ(*first->value, 1);
+  EXPECT_EQ(first->number, 1);
+  EXPECT_EQ(*published.Acquire()->value, 2);
+  EXPECT_EQ(published.GetVersion(), 2);
+}
+
+TEST(HotSwap, ReplicaFollowsModel) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  ::s21::NetworkReplica replica(model.GetPublishedNetwork());
+  const auto version = replica.GetVersion();
+  model.LoadWeights(path_weights);
+  EXPECT_TRUE(replica.Refresh());
+  EXPECT_GT(replica.GetVersion(), version);
+  EXPECT_FALSE(replica.Refresh());
+  for (std::size_t index = 0; index < reader.Size(); index += 9) {
+    const auto expected = model.ForwardFeed(reader[index].first);
+    const auto actual = replica.ForwardFeed(reader[index].first);
+    for (std::size_t row = 0; row < expected.GetRows(); ++row) {
+      EXPECT_EQ(actual(row, 0), expected(row, 0));
+    }
+  }
+  model.SetGraphNetwork();
+  model.Learn(reader);
+  EXPECT_TRUE(replica.Refresh());
+  const auto expected = model.ForwardFeed(reader[0].first);
+  const auto actual = replica.ForwardFeedIncremental(reader[0].first);
+  for (std::size_t row = 0; row < expected.GetRows(); ++row) {
+    EXPECT_NEAR(actual(row, 0), expected(row, 0), 1e-5);
+  }
+}
+
+TEST(HotSwap, InferenceDuringReloads) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> answers{0};
+  auto infer = [&] {
+    ::s21::NetworkReplica replica(model.GetPublishedNetwork());
+    for (std::size_t index = 0; !stop; ++index) {
+      const auto output =
+          replica.ForwardFeedIncremental(reader[index % reader.Size()].first);
+      EXPECT_EQ(output.GetRows(), ::s21::Model::outer_layer_size);
+      ++answers;
+    }
+  };
+  std::thread first(infer), second(infer);
+  for (std::size_t round = 0; round < 3; ++round) {
+    model.LoadWeights(path_weights);
+    model.SetGraphNetwork();
+    model.Learn(reader);
+    model.SetStaticNetwork();
+    model.SetHiddenLayers({32});
+    model.SetMatrixNetwork();
+  }
+  while (answers < 10) {
+    std::this_thread::yield();
+  }
+  stop = true;
+  first.join();
+  second.join();
+  EXPECT_GE(model.GetPublishedNetwork().GetVersion(), 18);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include "test.h"
+
+namespace {
+const std::string path_weights = "sample/weight_for_test.net";
+
+void DrawLetterByStrokes(::s21::Model &model) {
+  const auto letter = ::test::letter_a().second;
+  ::s21::Matrix<float> sensors(784, 1);
+  for (std::size_t i = 0; i < letter.size(); ++i) {
+    sensors(i, 0) = letter[i] / 255.f;
+    if (i % 16 != 0) {
+      continue;
+    }
+    auto incremental = model.ForwardFeedIncremental(sensors);
+    auto full = model.ForwardFeed(sensors);
+    for (std::size_t row = 0; row < full.GetRows(); ++row) {
+      EXPECT_NEAR(incremental(row, 0), full(row, 0), 1e-4);
+    }
+  }
+}
+}  // namespace
+
+TEST(Incremental, Matrix) {
+  ::s21::Model model;
+  model.SetMatrixNetwork();
+  model.LoadWeights(path_weights);
+  DrawLetterByStrokes(model);
+}
+
+TEST(Incremental, Graph) {
+  ::s21::Model model;
+  model.SetGraphNetwork();
+  model.LoadWeights(path_weights);
+  DrawLetterByStrokes(model);
+}
@@ -7,13 +7,19 @@ const std::string path_weights = "sample/weight_for_test.net";
 const std::string train_sample = "sample/train_for_test.csv";
 const std::string tmp_learn_path = "tmp_learn.net";
 const std::string weight_after_learn_path = "sample/weight_after_learn.net";
+const double weight_tolerance = 1e-4;
 } // namespace
 
 TEST(Learn, LoadReaderSave) {
   ::s21::Model model;
   model.LoadWeights(path_weights);
+  // Эталонные веса получены обучением в порядке файла
+  model.SetShuffle(false);
   ::s21::ReaderEMNIST train(train_sample);
   model.Learn(train);
   model.SaveWeights(tmp_learn_path);
-  EXPECT_TRUE(::test::CompareFiles(tmp_learn_path, weight_after_learn_path));
+  // Эталон снят до пропуска нулевых пикселей: порядок суммирования первого
+  // слоя изменился, поэтому веса сравниваются с допуском, а не побайтно
+  EXPECT_TRUE(::test::CompareWeights(tmp_learn_path, weight_after_learn_path,
+                                     weight_tolerance));
 }
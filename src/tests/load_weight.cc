@@ -1,9 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <fstream>
+
 #include "test.h"
 
 namespace {
 const std::string path_weights = "sample/weight_for_test.net";
+const std::string tmp_binary_path = "tmp_load_weight.bin";
+const std::string tmp_text_path = "tmp_load_weight.net";
 } // namespace
 
 TEST(LoadWeights, Matrix) {
@@ -12,6 +16,8 @@ TEST(LoadWeights, Matrix) {
   model.LoadWeights(path_weights);
   EXPECT_EQ(model.GetCountLayers(), 5);
   EXPECT_EQ(model.GetCountNeurons(), 64);
+  EXPECT_EQ(model.GetTopology(),
+            (std::vector<std::size_t>{784, 64, 64, 64, 64, 64, 26}));
   EXPECT_TRUE(model.IsMatrixNetwork());
   EXPECT_TRUE(::test::TestLetter(model, ::test::letter_r()));
 }
@@ -25,3 +31,77 @@ TEST(LoadWeights, Graph) {
   EXPECT_TRUE(model.IsGraphNetwork());
   EXPECT_TRUE(::test::TestLetter(model, ::test::letter_p()));
 }
+
+TEST(LoadWeights, BinaryRoundTrip) {
+  ::s21::Model source;
+  source.LoadWeights(path_weights);
+  source.SaveBinaryWeights(tmp_binary_path);
+  for (std::size_t network = 0; network < 3; ++network) {
+    ::s21::Model model;
+    if (network == 1) {
+      model.SetGraphNetwork();
+    } else if (network == 2) {
+      model.SetStaticNetwork();
+    }
+    model.LoadWeights(tmp_binary_path);
+    EXPECT_EQ(model.GetTopology(), source.GetTopology());
+    model.SaveWeights(tmp_text_path);
+    EXPECT_TRUE(test::CompareFiles(path_weights, tmp_text_path));
+    EXPECT_TRUE(::test::TestLetter(model, ::test::letter_r()));
+  }
+  std::remove(tmp_binary_path.c_str());
+  std::remove(tmp_text_path.c_str());
+}
+
+TEST(LoadWeights, TruncatedBinary) {
+  ::s21::ReaderEMNIST reader("sample/train_for_test.csv");
+  ::s21::Model source;
+  source.LoadWeights(path_weights);
+  source.SaveBinaryWeights(tmp_binary_path);
+  std::string data;
+  {
+    std::ifstream file{tmp_binary_path, std::ios::binary};
+    data.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  {
+    std::ofstream file{tmp_binary_path, std::ios::binary | std::ios::trunc};
+    file.write(data.data(), static_cast<std::streamsize>(data.size() - 4));
+  }
+  for (std::size_t network = 0; network < 3; ++network) {
+    ::s21::Model model;
+    if (network == 1) {
+      model.SetGraphNetwork();
+    } else if (network == 2) {
+      model.SetStaticNetwork();
+    }
+    const auto topology = model.GetTopology();
+    const auto expected = model.ForwardFeed(reader[0].first);
+    EXPECT_THROW(model.LoadWeights(tmp_binary_path), std::invalid_argument);
+    EXPECT_EQ(model.GetTopology(), topology);
+    const auto actual = model.ForwardFeed(reader[0].first);
+    const auto incremental = model.ForwardFeedIncremental(reader[0].first);
+    for (std::size_t row = 0; row < expected.GetRows(); ++row) {
+      EXPECT_EQ(actual(row, 0), expected(row, 0));
+      EXPECT_NEAR(incremental(row, 0), expected(row, 0), 1e-5f);
+    }
+  }
+  std::remove(tmp_binary_path.c_str());
+}
+
+TEST(LoadWeights, OversizedBinaryHeader) {
+  {
+    std::ofstream file{tmp_binary_path, std::ios::binary | std::ios::trunc};
+    file.write("S21WGHT1", 8);
+    for (const std::uint64_t size : {3ull, 784ull, 1ull << 20, 26ull}) {
+      file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    }
+    const float weight = 0.5f;
+    file.write(reinterpret_cast<const char *>(&weight), sizeof(weight));
+  }
+  ::s21::Model model;
+  model.SetGraphNetwork();
+  const auto topology = model.GetTopology();
+  EXPECT_THROW(model.LoadWeights(tmp_binary_path), std::invalid_argument);
+  EXPECT_EQ(model.GetTopology(), topology);
+  std::remove(tmp_binary_path.c_str());
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include "../model/loader/random.h"
+#include "test.h"
+
+namespace {
+const std::string train_sample = "sample/train_for_test.csv";
+}  // namespace
+
+TEST(LossCurve, KeepsEverySampleWhileBucketsLast) {
+  ::s21::LossCurve curve(8);
+  for (const double value : {0.5, 0.25, 1., 0.75}) {
+    curve.Add(value);
+  }
+  ASSERT_EQ(curve.GetBuckets().size(), 4);
+  EXPECT_EQ(curve.GetBucketWidth(), 1);
+  EXPECT_EQ(curve.Size(), 4);
+  EXPECT_DOUBLE_EQ(curve.Mean(), 0.625);
+  EXPECT_EQ(curve.GetBuckets()[2].begin, 2);
+  EXPECT_DOUBLE_EQ(curve.GetBuckets()[2].Mean(), 1.);
+}
+
+TEST(LossCurve, BoundedSummaryMatchesSamples) {
+  std::vector<double> values(100003);
+  std::uint64_t state = 7;
+  for (auto &value : values) {
+    value = ::s21::UnitFloat(state = ::s21::SplitMix(state));
+  }
+  ::s21::LossCurve curve(64);
+  for (const double value : values) {
+    curve.Add(value);
+  }
+  const auto &buckets = curve.GetBuckets();
+  EXPECT_LE(buckets.size(), 64);
+  EXPECT_GT(buckets.size(), 32);
+  EXPECT_EQ(curve.GetBucketWidth(), 2048);
+  std::size_t next = 0;
+  for (const auto &bucket : buckets) {
+    EXPECT_EQ(bucket.begin, next);
+    EXPECT_LE(bucket.count, curve.GetBucketWidth());
+    const auto begin = values.begin() + static_cast<long>(bucket.begin),
+               end = begin + static_cast<long>(bucket.count);
+    EXPECT_DOUBLE_EQ(bucket.min, *std::min_element(begin, end));
+    EXPECT_DOUBLE_EQ(bucket.max, *std::max_element(begin, end));
+    EXPECT_EQ(bucket.min_at,
+              std::min_element(begin, end) - values.begin());
+    EXPECT_EQ(bucket.max_at,
+              std::max_element(begin, end) - values.begin());
+    EXPECT_NEAR(bucket.sum, std::accumulate(begin, end, 0.), 1e-9);
+    next += bucket.count;
+  }
+  EXPECT_EQ(next, values.size());
+  EXPECT_EQ(curve.Size(), values.size());
+}
+
+TEST(LossCurve, RejectsOddBuckets) {
+  EXPECT_THROW(::s21::LossCurve(0), std::invalid_argument);
+  EXPECT_THROW(::s21::LossCurve(7), std::invalid_argument);
+}
+
+TEST(LossCurve, LearnReturnsSummary) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  const auto curve = model.Learn(reader);
+  EXPECT_EQ(curve.Size(), reader.Size());
+  EXPECT_EQ(curve.GetBuckets().size(), reader.Size());
+  EXPECT_GT(curve.Mean(), 0.);
+  for (const auto &bucket : curve.GetBuckets()) {
+    EXPECT_LE(bucket.min, bucket.max);
+  }
+}
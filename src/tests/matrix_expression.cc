@@ -0,0 +1,120 @@
+#include "../third-party/matrix.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace {
+using ::s21::Matrix;
+
+Matrix<float> Filled(std::size_t rows, std::size_t columns, float shift) {
+  Matrix<float> matrix(rows, columns);
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < columns; ++j) {
+      matrix(i, j) = std::sin(static_cast<float>(i * columns + j) + shift);
+    }
+  }
+  return matrix;
+}
+
+Matrix<float> NaiveProduct(const Matrix<float> &lhs, const Matrix<float> &rhs) {
+  Matrix<float> result(lhs.GetRows(), rhs.GetColumns());
+  for (std::size_t i = 0; i < lhs.GetRows(); ++i) {
+    for (std::size_t j = 0; j < rhs.GetColumns(); ++j) {
+      for (std::size_t k = 0; k < lhs.GetColumns(); ++k) {
+        result(i, j) += lhs(i, k) * rhs(k, j);
+      }
+    }
+  }
+  return result;
+}
+
+void ExpectNear(const Matrix<float> &left, const Matrix<float> &right) {
+  ASSERT_EQ(left.GetRows(), right.GetRows());
+  ASSERT_EQ(left.GetColumns(), right.GetColumns());
+  for (std::size_t i = 0; i < left.GetRows(); ++i) {
+    for (std::size_t j = 0; j < left.GetColumns(); ++j) {
+      EXPECT_NEAR(left(i, j), right(i, j), 1e-4f);
+    }
+  }
+}
+}  // namespace
+
+TEST(MatrixExpression, ElementWise) {
+  const auto a = Filled(3, 4, 0.f), b = Filled(3, 4, 1.f),
+             c = Filled(3, 4, 2.f);
+  Matrix<float> result = 2.f * (a + b) - c * 0.5f;
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      EXPECT_FLOAT_EQ(result(i, j),
+                      (a(i, j) + b(i, j)) * 2.f - c(i, j) * 0.5f);
+    }
+  }
+  EXPECT_THROW(Matrix<float>(a + Filled(4, 3, 0.f)), std::invalid_argument);
+}
+
+TEST(MatrixExpression, ProductMatchesNaive) {
+  for (const std::size_t inner : {1lu, 2lu, 5lu, 64lu}) {
+    const auto a = Filled(7, inner, 0.f), b = Filled(inner, 3, 1.f);
+    ExpectNear(a * b, NaiveProduct(a, b));
+    ExpectNear(Transpose(b) * Transpose(a),
+               NaiveProduct(a, b).Transpose());
+    ExpectNear((a + a) * b, NaiveProduct(a, b) * 2.f);
+  }
+  EXPECT_THROW(Matrix<float>(Filled(2, 3, 0.f) * Filled(2, 3, 0.f)),
+               std::invalid_argument);
+}
+
+TEST(MatrixExpression, FusedAffineActivation) {
+  const auto weights = Filled(5, 8, 0.f), bias = Filled(5, 1, 1.f),
+             x = Filled(8, 1, 2.f);
+  auto sigmoid = [](const float value) {
+    return 1.f / (1.f + std::exp(-value));
+  };
+  Matrix<float> expected = weights;
+  expected *= x;
+  expected += bias;
+  for (std::size_t i = 0; i < expected.GetRows(); ++i) {
+    expected(i, 0) = sigmoid(expected(i, 0));
+  }
+  Matrix<float> result(5, 1);
+  const float *buffer = &result(0, 0);
+  result = Apply(weights * x + bias, sigmoid);
+  EXPECT_EQ(&result(0, 0), buffer);
+  EXPECT_EQ(result, expected);
+}
+
+TEST(MatrixExpression, Aliasing) {
+  auto square = Filled(4, 4, 0.f);
+  const auto copy = square;
+  square = square * square;
+  ExpectNear(square, NaiveProduct(copy, copy));
+
+  square = copy;
+  square = Transpose(square);
+  EXPECT_EQ(square, copy.Transpose());
+
+  square = copy;
+  const float *buffer = &square(0, 0);
+  square += square * 2.f;
+  EXPECT_EQ(&square(0, 0), buffer);
+  ExpectNear(square, copy * 3.f);
+
+  auto vector = Filled(4, 1, 1.f);
+  vector = copy * vector + vector;
+  ExpectNear(vector,
+             NaiveProduct(copy, Filled(4, 1, 1.f)) + Filled(4, 1, 1.f));
+}
+
+TEST(MatrixExpression, StoredExpressionOwnsTemporaries) {
+  const auto a = Filled(3, 4, 0.f), b = Filled(4, 2, 1.f);
+  auto sum = a + Filled(3, 4, 1.f);
+  auto product = Filled(3, 4, 2.f) * b + Filled(3, 2, 3.f);
+  auto transposed = Apply(Transpose(Filled(4, 3, 4.f)), std::negate<>());
+  const auto noise = Filled(64, 64, 5.f);
+  ExpectNear(sum, Matrix<float>(a + Filled(3, 4, 1.f)));
+  ExpectNear(product,
+             NaiveProduct(Filled(3, 4, 2.f), b) + Filled(3, 2, 3.f));
+  ExpectNear(transposed, Filled(4, 3, 4.f).Transpose() * -1.f);
+  EXPECT_FALSE(sum.Refers(&noise));
+}
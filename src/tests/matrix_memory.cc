@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <thread>
+
+#include "test.h"
+
+namespace {
+const std::string path_weights = "sample/weight_for_test.net";
+const std::string train_sample = "sample/train_for_test.csv";
+}  // namespace
+
+TEST(MatrixMemory, PluggableResource) {
+  std::pmr::monotonic_buffer_resource buffer;
+  ::s21::Matrix<float> heap(4, 4);
+  EXPECT_EQ(heap.GetResource(), &::s21::MatrixHeap::Instance());
+  {
+    ::s21::MatrixResourceScope scope(&buffer);
+    ::s21::Matrix<float> local(4, 4);
+    EXPECT_EQ(local.GetResource(), &buffer);
+    local(1, 2) = 3.f;
+    heap = std::move(local);
+    ::s21::Matrix<float> explicit_heap(2, 2, &::s21::MatrixHeap::Instance());
+    EXPECT_EQ(explicit_heap.GetResource(), &::s21::MatrixHeap::Instance());
+  }
+  EXPECT_EQ(heap.GetResource(), &::s21::MatrixHeap::Instance());
+  EXPECT_EQ(heap(1, 2), 3.f);
+}
+
+TEST(MatrixMemory, ArenaStep) {
+  auto &arena = ::s21::MatrixArena::Local();
+  ::s21::Matrix<float> result(8, 1);
+  for (int step = 0; step < 3; ++step) {
+    ::s21::MatrixArena::Step scope;
+    ::s21::Matrix<float> weights(8, 16), input(16, 1);
+    EXPECT_EQ(weights.GetResource(), &arena);
+    weights(0, 0) = input(0, 0) = 2.f;
+    result = weights * input;
+    EXPECT_GT(arena.GetStats().bytes, 0u);
+  }
+  EXPECT_EQ(result.GetResource(), &::s21::MatrixHeap::Instance());
+  EXPECT_EQ(result(0, 0), 4.f);
+  EXPECT_EQ(arena.GetStats().bytes, 0u);
+  EXPECT_GE(arena.GetStats().peak_bytes, 16 * 8 * sizeof(float));
+}
+
+TEST(MatrixMemory, EscapedMatrixDefersReset) {
+  auto &arena = ::s21::MatrixArena::Local();
+  const auto skipped = arena.GetStats().skipped_resets;
+  const auto total = ::s21::MatrixArena::GetSkippedResets();
+  std::optional<::s21::Matrix<float>> escaped;
+  {
+    ::s21::MatrixArena::Step step;
+    ::s21::Matrix<float> local(4, 4);
+    escaped.emplace(std::move(local));
+  }
+  EXPECT_EQ(escaped->GetResource(), &arena);
+  EXPECT_EQ(arena.GetStats().skipped_resets, skipped + 1);
+  EXPECT_GT(arena.GetStats().bytes, 0u);
+  std::thread([&escaped] { escaped.reset(); }).join();
+  { ::s21::MatrixArena::Step step; }
+  EXPECT_EQ(arena.GetStats().skipped_resets, skipped + 1);
+  EXPECT_EQ(arena.GetStats().bytes, 0u);
+  EXPECT_EQ(::s21::MatrixArena::GetSkippedResets(), total + 1);
+}
+
+TEST(MatrixMemory, ArenaOutlivesFinishedThread) {
+  std::optional<::s21::Matrix<float>> escaped;
+  const ::s21::MatrixArena *arena = nullptr;
+  std::thread([&] {
+    arena = &::s21::MatrixArena::Local();
+    ::s21::MatrixArena::Step step;
+    ::s21::Matrix<float> local(4, 4);
+    local(3, 3) = 5.f;
+    escaped.emplace(std::move(local));
+  }).join();
+  EXPECT_EQ(escaped->GetResource(), arena);
+  (*escaped)(0, 0) = 1.f;
+  EXPECT_EQ((*escaped)(3, 3), 5.f);
+  EXPECT_EQ(arena->GetStats().skipped_resets, 1u);
+  escaped.reset();
+}
+
+TEST(MatrixMemory, LearnStaysOffHeap) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  std::vector<std::pair<::s21::Matrix<float>, std::size_t>> samples;
+  for (std::size_t index = 0; index < reader.Size(); ++index) {
+    samples.push_back(reader[index]);
+  }
+  ::s21::MatrixNetwork network({784, 64, 64, 26});
+  network.LoadWeights(path_weights);
+  network.Learn(samples[0].first, samples[0].second, 0.2f);
+  const auto heap = ::s21::MatrixHeap::Instance().GetStats();
+  const auto arena = ::s21::MatrixArena::Local().GetStats();
+  for (const auto &[sensors, answer] : samples) {
+    network.Learn(sensors, answer, 0.2f);
+  }
+  EXPECT_EQ(::s21::MatrixHeap::Instance().GetStats().allocations,
+            heap.allocations);
+  EXPECT_EQ(::s21::MatrixArena::Local().GetStats().upstream_allocations,
+            arena.upstream_allocations);
+  EXPECT_GT(::s21::MatrixArena::Local().GetStats().allocations,
+            arena.allocations);
+}
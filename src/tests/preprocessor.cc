@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "../model/preprocessor/image_preprocessor.h"
+
+namespace {
+constexpr std::size_t width = 280, height = 140, stride = 288;
+
+std::vector<std::uint8_t> WhiteImageWithLeftBar() {
+  std::vector<std::uint8_t> image(stride * height, 255);
+  for (std::size_t row = 0; row < height; ++row) {
+    for (std::size_t column = 0; column < width / 28; ++column) {
+      image[row * stride + column] = 0;
+    }
+  }
+  return image;
+}
+}  // namespace
+
+TEST(Preprocessor, DownscaleTransposeNormalize) {
+  ::s21::ImagePreprocessor preprocessor;
+  const auto image = WhiteImageWithLeftBar();
+  const auto &sensors =
+      preprocessor.Process(image.data(), width, height, stride);
+  ASSERT_EQ(sensors.GetRows(), 784);
+  for (std::size_t x = 0; x < 28; ++x) {
+    for (std::size_t y = 0; y < 28; ++y) {
+      EXPECT_FLOAT_EQ(sensors(x * 28 + y, 0), x == 0 ? 1.f : 0.f);
+    }
+  }
+}
+
+TEST(Preprocessor, BlurKeepsInkAndReusesBuffer) {
+  ::s21::ImagePreprocessor preprocessor(4.f);
+  const auto image = WhiteImageWithLeftBar();
+  const auto &first = preprocessor.Process(image.data(), width, height, stride);
+  const float *buffer = &first(0, 0);
+  const auto &second =
+      preprocessor.Process(image.data(), width, height, stride);
+  EXPECT_EQ(&second(0, 0), buffer);
+  EXPECT_GT(second(14, 0), 0.f);
+  EXPECT_LT(second(14, 0), 1.f);
+  EXPECT_GT(second(28 + 14, 0), 0.f);
+  EXPECT_FLOAT_EQ(second(27 * 28 + 14, 0), 0.f);
+}
+
+TEST(Preprocessor, UpscaleSmallImage) {
+  ::s21::ImagePreprocessor preprocessor(0.f, false);
+  std::vector<std::uint8_t> image{255, 0, 0, 255};
+  ::s21::Matrix<float> sensors(784, 1);
+  preprocessor.Process(image.data(), 2, 2, 2, sensors);
+  EXPECT_FLOAT_EQ(sensors(0, 0), 1.f);
+  EXPECT_FLOAT_EQ(sensors(27 * 28, 0), 0.f);
+  EXPECT_FLOAT_EQ(sensors(27 * 28 + 27, 0), 1.f);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "test.h"
+
+namespace {
+const std::string train_sample = "sample/train_for_test.csv";
+
+const ::s21::Profiler::PhaseStats &Phase(const ::s21::Profiler::Stats &stats,
+                                         ::s21::Profiler::Phase phase) {
+  return stats.phases[static_cast<std::size_t>(phase)];
+}
+}  // namespace
+
+TEST(Profiler, LearnFillsPhases) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  for (const bool graph : {false, true}) {
+    ::s21::Model model;
+    if (graph) {
+      model.SetGraphNetwork();
+    }
+    ::s21::Model::ResetProfile();
+    model.Learn(reader);
+    const auto stats = ::s21::Model::GetProfile();
+    if (!::s21::Profiler::enabled) {
+      EXPECT_EQ(stats.samples, 0);
+      continue;
+    }
+    EXPECT_EQ(stats.samples, reader.Size());
+    for (const auto phase :
+         {::s21::Profiler::Phase::Forward, ::s21::Profiler::Phase::Backward,
+          ::s21::Profiler::Phase::Update, ::s21::Profiler::Phase::Train}) {
+      EXPECT_GT(Phase(stats, phase).calls, 0);
+      EXPECT_GT(Phase(stats, phase).seconds, 0.);
+    }
+    EXPECT_EQ(Phase(stats, ::s21::Profiler::Phase::Train).calls, 1);
+    EXPECT_GT(stats.samples_per_sec, 0.);
+  }
+}
+
+TEST(Profiler, ResetZeroesCounters) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.Learn(reader);
+  ::s21::Model::ResetProfile();
+  const auto stats = ::s21::Model::GetProfile();
+  EXPECT_EQ(stats.samples, 0);
+  EXPECT_EQ(stats.samples_per_sec, 0.);
+  for (const auto &phase : stats.phases) {
+    EXPECT_EQ(phase.calls, 0);
+    EXPECT_EQ(phase.seconds, 0.);
+  }
+  EXPECT_GT(stats.allocations, 0);
+  EXPECT_GT(stats.peak_bytes, 0);
+}
+
+TEST(Profiler, FinishedThreadsReuseCounters) {
+  const auto parse = [] {
+    ::s21::Profiler::Add(::s21::Profiler::Phase::Parse,
+                         std::chrono::nanoseconds(1000));
+    ::s21::Profiler::AddSamples(1);
+  };
+  ::s21::Profiler::Reset();
+  std::thread(parse).join();
+  const auto counters = ::s21::Profiler::GetCounterCount();
+  for (int index = 0; index < 31; ++index) {
+    std::thread(parse).join();
+  }
+  EXPECT_EQ(::s21::Profiler::GetCounterCount(), counters);
+  const auto stats = ::s21::Profiler::GetStats();
+  EXPECT_EQ(stats.samples, 32);
+  EXPECT_EQ(Phase(stats, ::s21::Profiler::Phase::Parse).calls, 32);
+  EXPECT_DOUBLE_EQ(Phase(stats, ::s21::Profiler::Phase::Parse).seconds,
+                   32e-6);
+  ::s21::Profiler::Reset();
+  EXPECT_EQ(::s21::Profiler::GetStats().samples, 0);
+}
+
+TEST(Profiler, PhaseNames) {
+  EXPECT_STREQ(::s21::Profiler::GetPhaseName(::s21::Profiler::Phase::Parse),
+               "parse");
+  EXPECT_STREQ(::s21::Profiler::GetPhaseName(::s21::Profiler::Phase::Train),
+               "train");
+  EXPECT_STREQ(::s21::Profiler::GetPhaseName(::s21::Profiler::Phase::Count),
+               "unknown");
+}
@@ -1,9 +1,42 @@
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <iterator>
+
+#include "../model/reader/gzip_stream.h"
 #include "test.h"
 
 namespace {
 const std::string train_sample = "sample/train_for_test.csv";
+const std::string idx_images = "sample/emnist-test-images-idx3-ubyte";
+const std::string idx_labels = "sample/emnist-test-labels-idx1-ubyte";
+const std::string fixed_huffman = "sample/fixed_huffman.gz";
+const std::string tmp_path = "tmp_reader.gz";
+
+std::string ReadAll(const std::string &path) {
+    std::ifstream file{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>(file), {}};
+}
+
+std::string Inflate(const std::string &path) {
+    ::s21::GzipStream stream{path};
+    std::string data;
+    unsigned char buffer[1000];
+    for (std::size_t size = 0;
+         (size = stream.Read(buffer, sizeof(buffer))) != 0;) {
+        data.append(reinterpret_cast<const char *>(buffer), size);
+    }
+    return data;
+}
+
+void ExpectSameReaders(const ::s21::ReaderEMNIST &left,
+                       const ::s21::ReaderEMNIST &right) {
+    ASSERT_EQ(left.Size(), right.Size());
+    for (std::size_t index = 0; index < left.Size(); ++index) {
+        EXPECT_EQ(left[index].second, right[index].second);
+        EXPECT_TRUE(left[index].first == right[index].first);
+    }
+}
 } // namespace
 
 TEST(Reader, OpenFile) {
@@ -19,3 +52,35 @@ TEST(Reader, OpenFile) {
         EXPECT_EQ(line.first.GetColumns(), 1);
     }
 }
+
+TEST(Reader, IdxMatchesCsv) {
+    ::s21::ReaderEMNIST csv(train_sample);
+    ::s21::ReaderEMNIST idx(idx_images, idx_labels);
+    ExpectSameReaders(csv, idx);
+    ::s21::ReaderEMNIST found(idx_images);
+    ExpectSameReaders(csv, found);
+    ::s21::ReaderEMNIST compressed(idx_images + ".gz");
+    ExpectSameReaders(csv, compressed);
+}
+
+TEST(Reader, InflateBlockTypes) {
+    EXPECT_EQ(Inflate(idx_images + ".gz"), ReadAll(idx_images));
+    EXPECT_EQ(Inflate(idx_labels + ".gz"), ReadAll(idx_labels));
+    EXPECT_EQ(Inflate(fixed_huffman),
+              ReadAll(idx_images).substr(0, 4096) + ReadAll(idx_labels));
+    EXPECT_EQ(Inflate(idx_labels), ReadAll(idx_labels));
+    EXPECT_FALSE(::s21::GzipStream(idx_labels).IsCompressed());
+}
+
+TEST(Reader, InflateRejectsDamage) {
+    auto data = ReadAll(idx_images + ".gz");
+    data[data.size() - 6] ^= 1;
+    std::ofstream{tmp_path, std::ios::binary} << data;
+    EXPECT_THROW(Inflate(tmp_path), std::invalid_argument);
+    data.resize(data.size() / 2);
+    std::ofstream{tmp_path, std::ios::binary | std::ios::trunc} << data;
+    EXPECT_THROW(Inflate(tmp_path), std::invalid_argument);
+    EXPECT_THROW(::s21::ReaderEMNIST(tmp_path, idx_labels),
+                 std::invalid_argument);
+    std::remove(tmp_path.c_str());
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "test.h"
+
+namespace {
+const std::string path_weights = "sample/weight_for_test.net";
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string tmp_first_path = "tmp_static_first.net";
+const std::string tmp_second_path = "tmp_static_second.net";
+
+using TestStaticNetwork =
+    ::s21::StaticMatrixNetwork<784, 64, 64, 64, 64, 64, 26>;
+
+void ExpectNear(const ::s21::Matrix<float> &left,
+                const ::s21::Matrix<float> &right, float epsilon) {
+  ASSERT_EQ(left.GetRows(), right.GetRows());
+  for (std::size_t row = 0; row < left.GetRows(); ++row) {
+    EXPECT_NEAR(left(row, 0), right(row, 0), epsilon);
+  }
+}
+}  // namespace
+
+TEST(StaticNetwork, MatchesMatrixNetwork) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::MatrixNetwork dynamic({784, 64, 64, 26});
+  const auto topology = dynamic.LoadWeights(path_weights);
+  TestStaticNetwork fixed;
+  EXPECT_EQ(fixed.LoadWeights(path_weights), topology);
+  for (std::size_t index = 0; index < reader.Size(); ++index) {
+    ExpectNear(fixed.ForwardFeed(reader[index].first),
+               dynamic.ForwardFeed(reader[index].first), 1e-5f);
+  }
+  for (std::size_t index = 0; index < reader.Size(); ++index) {
+    fixed.Learn(reader[index].first, reader[index].second, 0.2f);
+    dynamic.Learn(reader[index].first, reader[index].second, 0.2f);
+    EXPECT_NEAR(fixed.GetLastMse(), dynamic.GetLastMse(), 1e-3);
+  }
+  ExpectNear(fixed.ForwardFeed(reader[0].first),
+             dynamic.ForwardFeed(reader[0].first), 1e-3f);
+  auto sum = fixed.GetFirstLayerSum(reader[1].first);
+  for (std::size_t sensor = 0; sensor < 784; ++sensor) {
+    fixed.AddFirstLayerDelta(sum, sensor,
+                             reader[0].first(sensor, 0) -
+                                 reader[1].first(sensor, 0));
+  }
+  ExpectNear(fixed.ForwardFeedFromFirstLayer(sum),
+             fixed.ForwardFeed(reader[0].first), 1e-4f);
+}
+
+TEST(StaticNetwork, SameWeightFiles) {
+  TestStaticNetwork fixed;
+  fixed.LoadWeights(path_weights);
+  fixed.SaveWeights(tmp_first_path);
+  auto copy = fixed.Clone();
+  copy->SaveWeights(tmp_second_path);
+  EXPECT_TRUE(test::CompareFiles(tmp_first_path, tmp_second_path));
+  ::s21::MatrixNetwork dynamic({784, 64, 64, 26});
+  dynamic.LoadWeights(path_weights);
+  dynamic.SaveWeights(tmp_second_path);
+  EXPECT_TRUE(test::CompareFiles(tmp_first_path, tmp_second_path));
+  ::s21::ShippedStaticMatrixNetwork shipped;
+  EXPECT_THROW(shipped.LoadWeights(path_weights), std::invalid_argument);
+  std::remove(tmp_first_path.c_str());
+  std::remove(tmp_second_path.c_str());
+}
+
+TEST(StaticNetwork, ModelUsesShippedTopology) {
+  ::s21::Model model;
+  model.SetStaticNetwork();
+  EXPECT_TRUE(model.IsStaticNetwork());
+  EXPECT_EQ(model.GetCountLayers(), 2);
+  model.LoadWeights(path_weights);
+  EXPECT_EQ(model.GetCountLayers(), 5);
+  EXPECT_TRUE(::test::TestLetter(model, ::test::letter_a()));
+  ::s21::ReaderEMNIST reader(train_sample);
+  model.SetCountLayers(2);
+  model.Learn(reader);
+  ExpectNear(model.ForwardFeedIncremental(reader[3].first),
+             model.ForwardFeed(reader[3].first), 1e-5f);
+}
+
+TEST(StaticNetwork, ModelReportsFallback) {
+  ::s21::Model model;
+  model.SetStaticNetwork();
+  EXPECT_TRUE(model.IsStaticNetwork());
+  EXPECT_FALSE(model.IsMatrixNetwork());
+  model.SetCountNeurons(32);
+  EXPECT_FALSE(model.IsStaticNetwork());
+  EXPECT_TRUE(model.IsMatrixNetwork());
+  EXPECT_FALSE(model.IsGraphNetwork());
+  model.SetCountNeurons(64);
+  EXPECT_TRUE(model.IsStaticNetwork());
+  EXPECT_FALSE(model.IsMatrixNetwork());
+  model.SetCountNeurons(32);
+  model.SetGraphNetwork();
+  EXPECT_FALSE(model.IsMatrixNetwork());
+  EXPECT_TRUE(model.IsGraphNetwork());
+}
@@ -0,0 +1,89 @@
+#include "../model/sweep.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+namespace {
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string tmp_results_path = "tmp_sweep.csv";
+}  // namespace
+
+TEST(Sweep, SearchSpace) {
+  ::s21::Sweep::SearchSpace space;
+  space.networks = {::s21::Sweep::Network::Matrix,
+                    ::s21::Sweep::Network::Graph};
+  space.count_neurons = {32, 64};
+  space.learning_rates = {0.05f, 0.5f};
+  EXPECT_EQ(::s21::Sweep::Grid(space).size(), 2 * 4 * 2 * 2);
+  auto first = ::s21::Sweep::Random(space, 20, 7);
+  auto second = ::s21::Sweep::Random(space, 20, 7);
+  ASSERT_EQ(first.size(), 20);
+  for (std::size_t index = 0; index < first.size(); ++index) {
+    EXPECT_EQ(first[index].count_layers, second[index].count_layers);
+    EXPECT_EQ(first[index].learning_rate, second[index].learning_rate);
+    EXPECT_GE(first[index].count_layers, 2);
+    EXPECT_LE(first[index].count_layers, 5);
+    EXPECT_GE(first[index].learning_rate, 0.0499f);
+    EXPECT_LE(first[index].learning_rate, 0.5001f);
+  }
+  space.count_layers.clear();
+  EXPECT_THROW(::s21::Sweep::Grid(space), std::invalid_argument);
+}
+
+TEST(Sweep, RunRanksAndPrunes) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Sweep::Options options;
+  options.count_threads = 2;
+  options.median_pruning = false;
+  const std::vector<::s21::Sweep::Config> configs = {
+      {::s21::Sweep::Network::Matrix, 2, 16, 0.2f},
+      {::s21::Sweep::Network::Graph, 2, 16, 0.2f},
+      {::s21::Sweep::Network::Matrix, 0, 16, 0.2f},
+      {::s21::Sweep::Network::Matrix, 3, 16, 0.5f}};
+  auto results = ::s21::Sweep(options).Run(configs, reader, reader);
+  ASSERT_EQ(results.size(), configs.size());
+  EXPECT_TRUE(results.back().pruned);
+  EXPECT_FALSE(results.back().error.empty());
+  for (std::size_t index = 0; index + 1 < results.size(); ++index) {
+    EXPECT_FALSE(results[index].pruned);
+    EXPECT_EQ(results[index].epochs, 1);
+    EXPECT_GT(results[index].latency_ms, 0.);
+    if (index != 0) {
+      EXPECT_GE(results[index - 1].test.average_accuracy,
+                results[index].test.average_accuracy);
+    }
+  }
+  ::s21::Sweep::SaveResults(results, tmp_results_path);
+  std::ifstream file(tmp_results_path);
+  std::size_t lines = 0;
+  for (std::string line; std::getline(file, line);) {
+    ++lines;
+  }
+  EXPECT_EQ(lines, results.size() + 1);
+  std::remove(tmp_results_path.c_str());
+
+  options.prune_mse = 1e-9;
+  for (const auto &result :
+       ::s21::Sweep(options).Run(configs, reader, reader)) {
+    EXPECT_TRUE(result.pruned);
+    EXPECT_EQ(result.epochs, 0);
+  }
+}
+
+TEST(Sweep, ReportsRealEngine) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Sweep::Options options;
+  options.count_threads = 1;
+  options.prune_mse = 1e-9;
+  const std::vector<::s21::Sweep::Config> configs = {
+      {::s21::Sweep::Network::Static, 2, 64, 0.2f},
+      {::s21::Sweep::Network::Static, 2, 16, 0.2f}};
+  auto results = ::s21::Sweep(options).Run(configs, reader, reader);
+  ASSERT_EQ(results.size(), configs.size());
+  for (const auto &result : results) {
+    EXPECT_EQ(result.engine, result.config.count_neurons == 64
+                                 ? ::s21::Sweep::Network::Static
+                                 : ::s21::Sweep::Network::Matrix);
+  }
+}
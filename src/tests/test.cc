@@ -1,5 +1,6 @@
 #include "test.h"
 
+#include <cmath>
 #include <fstream>
 
 namespace test {
@@ -166,4 +167,23 @@ bool CompareFiles(const std::string &l_file_path, const std::string &r_file_path
   return true;
 }
 
+bool CompareWeights(const std::string &l_file_path,
+                    const std::string &r_file_path, double tolerance) {
+  std::ifstream l_file(l_file_path);
+  std::ifstream r_file(r_file_path);
+
+  if (!l_file.is_open() || !r_file.is_open()) {
+    return false;
+  }
+
+  double l_value = 0.;
+  double r_value = 0.;
+  while (l_file >> l_value) {
+    if (!(r_file >> r_value) || std::fabs(l_value - r_value) > tolerance) {
+      return false;
+    }
+  }
+  return l_file.eof() && !(r_file >> r_value) && r_file.eof();
+}
+
 } // namespace test
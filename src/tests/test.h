@@ -45,4 +45,7 @@ bool TestLetter(s21::Model &model,
 bool CompareFiles(const std::string &l_file_path,
                   const std::string &r_file_path);
 
+bool CompareWeights(const std::string &l_file_path,
+                    const std::string &r_file_path, double tolerance);
+
 }  // namespace test
\ No newline at end of file
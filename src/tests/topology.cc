@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "test.h"
+
+namespace {
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string tmp_path = "tmp_topology.net";
+
+void ExpectSameOutput(::s21::Model &left, ::s21::Model &right,
+                      const ::s21::ReaderEMNIST &reader) {
+  for (std::size_t index = 0; index < reader.Size(); index += 7) {
+    auto first = left.ForwardFeed(reader[index].first);
+    auto second = right.ForwardFeed(reader[index].first);
+    for (std::size_t row = 0; row < first.GetRows(); ++row) {
+      EXPECT_NEAR(first(row, 0), second(row, 0), 1e-5);
+    }
+  }
+}
+}  // namespace
+
+TEST(Topology, TaperedRoundTrip) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  for (const bool graph : {false, true}) {
+    ::s21::Model model;
+    if (graph) {
+      model.SetGraphNetwork();
+    }
+    model.SetHiddenLayers({96, 32});
+    EXPECT_EQ(model.GetTopology(),
+              (std::vector<std::size_t>{784, 96, 32, 26}));
+    EXPECT_EQ(model.GetCountLayers(), 2);
+    EXPECT_EQ(model.GetCountNeurons(), 96);
+    model.Learn(reader);
+    model.SaveWeights(tmp_path);
+
+    ::s21::Model loaded;
+    if (graph) {
+      loaded.SetGraphNetwork();
+    }
+    loaded.LoadWeights(tmp_path);
+    EXPECT_EQ(loaded.GetHiddenLayers(), model.GetHiddenLayers());
+    ExpectSameOutput(model, loaded, reader);
+  }
+  std::remove(tmp_path.c_str());
+}
+
+TEST(Topology, ArbitraryDepth) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  for (const std::size_t count_layers : {1lu, 8lu}) {
+    model.SetCountLayers(count_layers);
+    model.SetCountNeurons(16);
+    EXPECT_EQ(model.GetHiddenLayers(),
+              std::vector<std::size_t>(count_layers, 16));
+    model.Learn(reader);
+    EXPECT_EQ(model.ForwardFeed(reader[0].first).GetRows(), 26);
+  }
+  model.SetHiddenLayers({64, 8});
+  model.SetCountLayers(3);
+  EXPECT_EQ(model.GetHiddenLayers(), (std::vector<std::size_t>{64, 8, 8}));
+  EXPECT_THROW(model.SetHiddenLayers({}), std::invalid_argument);
+  EXPECT_THROW(model.SetHiddenLayers({64, 0}), std::invalid_argument);
+  EXPECT_THROW(::s21::MatrixNetwork({784, 26}), std::invalid_argument);
+  EXPECT_THROW(::s21::GraphNetwork({784, 26}), std::invalid_argument);
+}
+
+TEST(Topology, MismatchedWeightFile) {
+  std::ofstream file{tmp_path};
+  file << "2\n2 3\n1 1 1\n1 1 1\n2 1\n0\n0\n1 4\n1 1 1 1\n1 1\n0\n";
+  file.close();
+  ::s21::Model model;
+  EXPECT_THROW(model.LoadWeights(tmp_path), std::invalid_argument);
+  EXPECT_EQ(model.GetCountLayers(), 2);
+  EXPECT_THROW(model.LoadWeights("missing.net"), std::invalid_argument);
+  std::remove(tmp_path.c_str());
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include "test.h"
+
+namespace {
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string tmp_path = "tmp_trace.json";
+
+std::size_t CountEvents(const std::vector<::s21::Tracer::Event> &events,
+                        const char *name) {
+  return std::count_if(events.begin(), events.end(),
+                       [name](const ::s21::Tracer::Event &event) {
+                         return std::strcmp(event.name, name) == 0;
+                       });
+}
+}  // namespace
+
+TEST(Tracer, LearnSpans) {
+  ::s21::Model::StartTrace();
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.Learn(reader);
+  model.SaveWeights(tmp_path);
+  ::s21::Model::SaveTrace({});
+  const auto events = ::s21::Tracer::GetEvents();
+  if (!::s21::Profiler::enabled) {
+    EXPECT_TRUE(events.empty());
+    return;
+  }
+  EXPECT_EQ(CountEvents(events, "ReaderEMNIST::OpenFile"), 1);
+  EXPECT_EQ(CountEvents(events, "Model::Learn epoch"), 1);
+  EXPECT_EQ(CountEvents(events, "Model::Learn batch"),
+            (reader.Size() + ::s21::Model::loader_batch_size - 1) /
+                ::s21::Model::loader_batch_size);
+  EXPECT_EQ(CountEvents(events, "MatrixNetwork::Learn"), reader.Size());
+  EXPECT_EQ(CountEvents(events, "MatrixNetwork::SaveWeights"), 1);
+  for (const auto &event : events) {
+    EXPECT_GE(event.begin, 0);
+    EXPECT_GE(event.duration, 0);
+  }
+  EXPECT_EQ(::s21::Tracer::GetDropped(), 0);
+  std::remove(tmp_path.c_str());
+}
+
+TEST(Tracer, StoppedRecordsNothing) {
+  ::s21::Model::StartTrace();
+  ::s21::Model::SaveTrace({});
+  EXPECT_FALSE(::s21::Tracer::IsEnabled());
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.Learn(reader);
+  EXPECT_TRUE(::s21::Tracer::GetEvents().empty());
+}
+
+TEST(Tracer, ThreadsGetOwnTracks) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.SetKValid(3);
+  model.SetCountEpoch(1);
+  ::s21::Model::StartTrace();
+  model.CrossValidation(reader);
+  ::s21::Model::SaveTrace(tmp_path);
+  if (!::s21::Profiler::enabled) {
+    return;
+  }
+  std::set<std::uint32_t> threads;
+  for (const auto &event : ::s21::Tracer::GetEvents()) {
+    if (std::strcmp(event.name, "MatrixNetwork::Learn") == 0) {
+      threads.insert(event.thread);
+    }
+  }
+  // Блоки кросс-валидации разбирают не больше hardware_concurrency потоков
+  EXPECT_EQ(threads.size(),
+            std::min(3u, std::max(std::thread::hardware_concurrency(), 1u)));
+
+  std::ifstream file{tmp_path};
+  std::stringstream json;
+  json << file.rdbuf();
+  const auto text = json.str();
+  EXPECT_EQ(text.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+  EXPECT_NE(text.find("\"name\":\"MatrixNetwork::ForwardFeed\""),
+            std::string::npos);
+  EXPECT_NE(text.find("\"ph\":\"X\""), std::string::npos);
+  EXPECT_EQ(text.substr(text.size() - 4), "\n]}\n");
+  std::remove(tmp_path.c_str());
+}
+
+TEST(Tracer, FinishedThreadsReuseRings) {
+  const auto record = [] {
+    ::s21::Tracer::Record("worker", ::s21::Tracer::Now(),
+                          ::s21::Tracer::Now());
+  };
+  ::s21::Tracer::Start();
+  std::thread(record).join();
+  const auto rings = ::s21::Tracer::GetRingCount();
+  for (std::size_t index = 0; index < 3 * ::s21::Tracer::retired_limit;
+       ++index) {
+    std::thread(record).join();
+  }
+  EXPECT_LE(::s21::Tracer::GetRingCount(),
+            rings + ::s21::Tracer::retired_limit);
+  EXPECT_EQ(CountEvents(::s21::Tracer::GetEvents(), "worker"),
+            ::s21::Tracer::retired_limit);
+  EXPECT_EQ(::s21::Tracer::GetDropped(),
+            2 * ::s21::Tracer::retired_limit + 1);
+  const auto peak = ::s21::Tracer::GetRingCount();
+  ::s21::Tracer::Start();
+  for (std::size_t index = 0; index < ::s21::Tracer::retired_limit; ++index) {
+    std::thread(record).join();
+  }
+  ::s21::Tracer::Stop();
+  EXPECT_EQ(::s21::Tracer::GetRingCount(), peak);
+  EXPECT_EQ(CountEvents(::s21::Tracer::GetEvents(), "worker"),
+            ::s21::Tracer::retired_limit);
+  EXPECT_EQ(::s21::Tracer::GetDropped(), 0);
+}
+
+TEST(Tracer, BadPath) {
+  ::s21::Model::StartTrace();
+  EXPECT_THROW(::s21::Model::SaveTrace("no_such_dir/trace.json"),
+               std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "test.h"
+
+namespace {
+const std::string path_weights = "sample/weight_for_test.net";
+const std::string train_sample = "sample/train_for_test.csv";
+const std::string tmp_fit_path = "tmp_validation_fit.net";
+const std::string tmp_learn_path = "tmp_validation_learn.net";
+}  // namespace
+
+TEST(Validation, EarlyStoppingKeepsBestWeights) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.LoadWeights(path_weights);
+  model.SetCountEpoch(5);
+  model.SetValidationOptions({0, 1, 1e9});
+  auto output = model.Fit(reader, reader);
+  EXPECT_TRUE(output.stopped);
+  // Валидация идет в фоне, поэтому итог второй проверки известен после
+  // третьей эпохи
+  EXPECT_EQ(output.mse.size(), 3);
+  EXPECT_EQ(output.validation_mse.size(), 2);
+  EXPECT_EQ(output.validation_steps,
+            (std::vector<std::size_t>{reader.Size(), 2 * reader.Size()}));
+  EXPECT_EQ(output.best, 0);
+  model.SaveWeights(tmp_fit_path);
+
+  ::s21::Model expected;
+  expected.LoadWeights(path_weights);
+  expected.Learn(reader);
+  expected.SaveWeights(tmp_learn_path);
+  EXPECT_TRUE(test::CompareFiles(tmp_fit_path, tmp_learn_path));
+  std::remove(tmp_fit_path.c_str());
+  std::remove(tmp_learn_path.c_str());
+}
+
+TEST(Validation, PeriodInSteps) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.LoadWeights(path_weights);
+  model.SetCountEpoch(2);
+  model.SetValidationOptions({20, 0, 0.});
+  auto output = model.Fit(reader, reader);
+  EXPECT_FALSE(output.stopped);
+  EXPECT_EQ(output.mse.size(), 2);
+  EXPECT_EQ(output.mse[0].Size(), reader.Size());
+  EXPECT_EQ(output.validation_mse.size(), 2 * reader.Size() / 20);
+  ASSERT_EQ(output.validation_steps.size(), output.validation_mse.size());
+  for (std::size_t index = 0; index < output.validation_steps.size();
+       ++index) {
+    EXPECT_EQ(output.validation_steps[index], 20 * (index + 1));
+  }
+  EXPECT_LT(output.best, output.validation_mse.size());
+  for (const double mse : output.validation_mse) {
+    EXPECT_GE(output.validation_mse[output.best], 0.);
+    EXPECT_LE(output.validation_mse[output.best], mse);
+  }
+}
+
+TEST(Validation, StepInterruptsFit) {
+  ::s21::ReaderEMNIST reader(train_sample);
+  ::s21::Model model;
+  model.LoadWeights(path_weights);
+  model.SetCountEpoch(3);
+  std::size_t steps = 0;
+  auto output = model.Fit(reader, reader, [&](double) { return ++steps < 10; });
+  EXPECT_TRUE(output.stopped);
+  ASSERT_EQ(output.mse.size(), 1);
+  EXPECT_EQ(output.mse[0].Size(), 10);
+  EXPECT_EQ(steps, 10);
+}
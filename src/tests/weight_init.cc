@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "test.h"
+
+namespace {
+using Scheme = ::s21::WeightInit::Scheme;
+
+void ExpectSameWeights(const ::s21::BaseNetwork &left,
+                       const ::s21::BaseNetwork &right) {
+  const auto first = left.GetLayerMatrices();
+  const auto second = right.GetLayerMatrices();
+  ASSERT_EQ(first.size(), second.size());
+  for (std::size_t layer = 0; layer < first.size(); ++layer) {
+    EXPECT_TRUE(first[layer].first == second[layer].first);
+  }
+}
+}  // namespace
+
+TEST(WeightInit, PhiloxKnownAnswer) {
+  const auto zero = ::s21::Philox({0, 0, 0, 0}, {0, 0});
+  EXPECT_EQ(zero[0], 0x6627e8d5u);
+  EXPECT_EQ(zero[1], 0xe169c58du);
+  EXPECT_EQ(zero[2], 0xbc57ac4cu);
+  EXPECT_EQ(zero[3], 0x9b00dbd8u);
+}
+
+TEST(WeightInit, IndependentOfThreadsAndLayout) {
+  const std::size_t rows = 301, cols = 707;
+  const ::s21::WeightInit init{17, Scheme::He};
+  std::vector<float> serial(rows * cols), parallel(rows * cols),
+      columns(rows * cols);
+  ::s21::FillWeights(serial.data(), rows, cols, 2, init, false, 1);
+  ::s21::FillWeights(parallel.data(), rows, cols, 2, init, false, 7);
+  ::s21::FillWeights(columns.data(), rows, cols, 2, init, true);
+  EXPECT_EQ(serial, parallel);
+  for (std::size_t row = 0; row < rows; ++row) {
+    for (std::size_t col = 0; col < cols; ++col) {
+      ASSERT_EQ(serial[row * cols + col], columns[col * rows + row]);
+    }
+  }
+}
+
+TEST(WeightInit, SchemesMatchTheirScale) {
+  const std::size_t rows = 256, cols = 512;
+  std::vector<float> weights(rows * cols);
+  ::s21::FillWeights(weights.data(), rows, cols, 0, {3, Scheme::Xavier});
+  const float limit = std::sqrt(6.f / (rows + cols));
+  for (const float weight : weights) {
+    ASSERT_LE(std::abs(weight), limit);
+  }
+  ::s21::FillWeights(weights.data(), rows, cols, 0, {3, Scheme::He});
+  double sum = 0, squares = 0;
+  for (const float weight : weights) {
+    sum += weight;
+    squares += weight * weight;
+  }
+  const double mean = sum / weights.size();
+  EXPECT_NEAR(mean, 0., 1e-3);
+  EXPECT_NEAR(squares / weights.size() - mean * mean, 2. / cols, 2e-4);
+}
+
+TEST(WeightInit, SameSeedSameNetworks) {
+  const std::vector<std::size_t> topology{784, 64, 64, 26};
+  const ::s21::WeightInit init{5, Scheme::Xavier};
+  const ::s21::MatrixNetwork matrix(topology, init);
+  const ::s21::GraphNetwork graph(topology, init);
+  const ::s21::ShippedStaticMatrixNetwork fixed(init);
+  ExpectSameWeights(matrix, graph);
+  ExpectSameWeights(matrix, fixed);
+  const ::s21::MatrixNetwork other(topology, {6, Scheme::Xavier});
+  EXPECT_FALSE(other.GetLayerMatrices()[0].first ==
+               matrix.GetLayerMatrices()[0].first);
+}
+
+TEST(WeightInit, ModelReproducible) {
+  ::s21::Model first, second;
+  for (auto *model : {&first, &second}) {
+    model->SetSeed(11);
+    model->SetWeightInit(Scheme::He);
+  }
+  EXPECT_EQ(first.GetWeightInit(), Scheme::He);
+  ExpectSameWeights(*first.GetPublishedNetwork().Acquire()->value,
+                    *second.GetPublishedNetwork().Acquire()->value);
+}
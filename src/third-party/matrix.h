@@ -3,23 +3,62 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "matrix_memory.h"
 
 namespace s21 {
 
+// Ленивые матричные выражения. Каждый узел дает GetRows, GetColumns, At,
+// Refers (читает ли выражение данную матрицу) и Aliases (нельзя ли вычислить
+// выражение на месте данной матрицы). Вычисление происходит только при
+// присваивании матрице: все дерево считается поэлементно за один проход
+// прямо в память назначения.
+template <class E>
+class MatrixExpression {
+ public:
+  const E &Self() const noexcept { return static_cast<const E &>(*this); }
+};
+
+template <class E>
+using IsMatrixExpression =
+    std::is_base_of<MatrixExpression<std::decay_t<E>>, std::decay_t<E>>;
+
+template <class E>
+using EnableIfMatrixExpression =
+    std::enable_if_t<IsMatrixExpression<E>::value, int>;
+
 template <class T>
-class Matrix {
+class Matrix : public MatrixExpression<Matrix<T>> {
   static_assert(std::is_arithmetic<T>(),
                 "Matrix template type must be arithmetic");
 
  public:
+  using value_type = T;
+
   Matrix();
   Matrix(std::size_t rows, std::size_t columns);
+  Matrix(std::size_t rows, std::size_t columns,
+         std::pmr::memory_resource *resource);
   Matrix(const Matrix &other);
   Matrix(Matrix &&other);
+  template <class E>
+  Matrix(const MatrixExpression<E> &expression);
 
   Matrix &operator=(const Matrix &other);
   Matrix &operator=(Matrix &&other);
+  template <class E>
+  Matrix &operator=(const MatrixExpression<E> &expression);
+  template <class E>
+  Matrix &operator+=(const MatrixExpression<E> &expression);
+  template <class E>
+  Matrix &operator-=(const MatrixExpression<E> &expression);
 
   Matrix &operator*=(T value);
   Matrix &operator*=(const Matrix &other);
@@ -29,6 +68,11 @@ class Matrix {
   ~Matrix();
 
   T &operator()(std::size_t rows, std::size_t columns) const;
+  T At(std::size_t row, std::size_t column) const noexcept;
+  bool Refers(const void *target) const noexcept;
+  bool Aliases(const void *target) const noexcept;
+  void Swap(Matrix &other) noexcept;
+  std::pmr::memory_resource *GetResource() const noexcept;
 
   std::size_t GetColumns() const noexcept;
   std::size_t GetRows() const noexcept;
@@ -54,11 +98,266 @@ class Matrix {
  private:
   void CheckEqSize(const Matrix &other) const;
   void AllocMemory();
+  void FreeMemory() noexcept;
+  std::size_t DataBytes() const noexcept;
+  template <class E>
+  void Assign(const E &source);
 
   std::size_t rows_, columns_;
+  std::pmr::memory_resource *resource_ = GetMatrixResource();
   T **matrix_;
 };
 
+// Тип узла для операнда, переданного как E&&. Матрицы-lvalue хранятся по
+// ссылке, а временные матрицы и вложенные выражения переносятся в узел по
+// значению, поэтому выражение можно сохранить в auto без висячих ссылок.
+template <class E>
+struct ExpressionOperand {
+  using type = std::decay_t<E>;
+};
+
+template <class T>
+struct ExpressionOperand<Matrix<T> &> {
+  using type = const Matrix<T> &;
+};
+
+template <class T>
+struct ExpressionOperand<const Matrix<T> &> {
+  using type = const Matrix<T> &;
+};
+
+template <class E>
+using ExpressionOperandT = typename ExpressionOperand<E>::type;
+
+template <class L, class R, class Operation>
+class MatrixBinary : public MatrixExpression<MatrixBinary<L, R, Operation>> {
+ public:
+  using value_type = typename std::decay_t<L>::value_type;
+
+  template <class Left, class Right>
+  MatrixBinary(Left &&lhs, Right &&rhs, Operation operation)
+      : lhs_(std::forward<Left>(lhs)),
+        rhs_(std::forward<Right>(rhs)),
+        operation_(operation) {
+    if (lhs_.GetRows() != rhs_.GetRows() ||
+        lhs_.GetColumns() != rhs_.GetColumns()) {
+      throw std::invalid_argument("Wrong matrix, different Size");
+    }
+  }
+
+  std::size_t GetRows() const noexcept { return lhs_.GetRows(); }
+  std::size_t GetColumns() const noexcept { return lhs_.GetColumns(); }
+  value_type At(std::size_t row, std::size_t column) const {
+    return operation_(lhs_.At(row, column), rhs_.At(row, column));
+  }
+  bool Refers(const void *target) const noexcept {
+    return lhs_.Refers(target) || rhs_.Refers(target);
+  }
+  bool Aliases(const void *target) const noexcept {
+    return lhs_.Aliases(target) || rhs_.Aliases(target);
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+  Operation operation_;
+};
+
+template <class E, class Function>
+class MatrixUnary : public MatrixExpression<MatrixUnary<E, Function>> {
+ public:
+  using value_type = typename std::decay_t<E>::value_type;
+
+  template <class Source>
+  MatrixUnary(Source &&source, Function function)
+      : source_(std::forward<Source>(source)), function_(function) {}
+
+  std::size_t GetRows() const noexcept { return source_.GetRows(); }
+  std::size_t GetColumns() const noexcept { return source_.GetColumns(); }
+  value_type At(std::size_t row, std::size_t column) const {
+    return function_(source_.At(row, column));
+  }
+  bool Refers(const void *target) const noexcept {
+    return source_.Refers(target);
+  }
+  bool Aliases(const void *target) const noexcept {
+    return source_.Aliases(target);
+  }
+
+ private:
+  E source_;
+  Function function_;
+};
+
+template <class E>
+class MatrixTranspose : public MatrixExpression<MatrixTranspose<E>> {
+ public:
+  using value_type = typename std::decay_t<E>::value_type;
+
+  template <class Source,
+            std::enable_if_t<!std::is_same_v<std::decay_t<Source>,
+                                             MatrixTranspose>,
+                             int> = 0>
+  explicit MatrixTranspose(Source &&source)
+      : source_(std::forward<Source>(source)) {}
+
+  std::size_t GetRows() const noexcept { return source_.GetColumns(); }
+  std::size_t GetColumns() const noexcept { return source_.GetRows(); }
+  value_type At(std::size_t row, std::size_t column) const {
+    return source_.At(column, row);
+  }
+  bool Refers(const void *target) const noexcept {
+    return source_.Refers(target);
+  }
+  bool Aliases(const void *target) const noexcept {
+    return source_.Refers(target);
+  }
+
+ private:
+  E source_;
+};
+
+// Операнды произведения читаются многократно, поэтому составные выражения
+// вычисляются один раз, а матрицы и их транспонирования читаются напрямую.
+template <class E>
+struct ProductOperand {
+  using type = Matrix<typename E::value_type>;
+};
+
+template <class T>
+struct ProductOperand<const Matrix<T> &> {
+  using type = const Matrix<T> &;
+};
+
+template <class T>
+struct ProductOperand<MatrixTranspose<const Matrix<T> &>> {
+  using type = MatrixTranspose<const Matrix<T> &>;
+};
+
+template <class T>
+struct ProductOperand<MatrixTranspose<Matrix<T>>> {
+  using type = MatrixTranspose<Matrix<T>>;
+};
+
+// Произведение Винограда. Множители строк и столбцов готовятся при создании,
+// элементы суммируются в том же порядке, что и в немедленном алгоритме.
+template <class L, class R>
+class MatrixProduct : public MatrixExpression<MatrixProduct<L, R>> {
+ public:
+  using value_type = typename std::decay_t<L>::value_type;
+
+  template <class Left, class Right>
+  MatrixProduct(Left &&lhs, Right &&rhs)
+      : lhs_(std::forward<Left>(lhs)), rhs_(std::forward<Right>(rhs)) {
+    if (lhs_.GetColumns() != rhs_.GetRows()) {
+      throw std::invalid_argument(
+          "Wrong matrix, different Size first matrix "
+          "columns and second matrix rows");
+    }
+    const std::size_t half = lhs_.GetColumns() / 2;
+    row_factors_.resize(lhs_.GetRows());
+    for (std::size_t i = 0; half != 0 && i < row_factors_.size(); ++i) {
+      row_factors_[i] = lhs_.At(i, 0) * lhs_.At(i, 1);
+      for (std::size_t k = 1; k < half; ++k) {
+        row_factors_[i] += lhs_.At(i, 2 * k) * lhs_.At(i, 2 * k + 1);
+      }
+    }
+    column_factors_.resize(rhs_.GetColumns());
+    for (std::size_t j = 0; half != 0 && j < column_factors_.size(); ++j) {
+      column_factors_[j] = rhs_.At(0, j) * rhs_.At(1, j);
+      for (std::size_t k = 1; k < half; ++k) {
+        column_factors_[j] += rhs_.At(2 * k, j) * rhs_.At(2 * k + 1, j);
+      }
+    }
+  }
+
+  std::size_t GetRows() const noexcept { return lhs_.GetRows(); }
+  std::size_t GetColumns() const noexcept { return rhs_.GetColumns(); }
+  value_type At(std::size_t row, std::size_t column) const {
+    const std::size_t inner = lhs_.GetColumns();
+    value_type result = -row_factors_[row] - column_factors_[column];
+    for (std::size_t k = 0; k < inner / 2; ++k) {
+      result += (lhs_.At(row, 2 * k) + rhs_.At(2 * k + 1, column)) *
+                (lhs_.At(row, 2 * k + 1) + rhs_.At(2 * k, column));
+    }
+    if (inner % 2 == 1) {
+      result += lhs_.At(row, inner - 1) * rhs_.At(inner - 1, column);
+    }
+    return result;
+  }
+  bool Refers(const void *target) const noexcept {
+    return lhs_.Refers(target) || rhs_.Refers(target);
+  }
+  bool Aliases(const void *target) const noexcept { return Refers(target); }
+
+ private:
+  typename ProductOperand<L>::type lhs_;
+  typename ProductOperand<R>::type rhs_;
+  std::vector<value_type> row_factors_, column_factors_;
+};
+
+template <class T>
+struct MatrixScale {
+  T operator()(T item) const { return item * value; }
+  T value;
+};
+
+template <class E, class Function, EnableIfMatrixExpression<E> = 0>
+[[nodiscard]] auto Apply(E &&expression, Function function) {
+  return MatrixUnary<ExpressionOperandT<E>, Function>(
+      std::forward<E>(expression), function);
+}
+
+template <class E, EnableIfMatrixExpression<E> = 0>
+[[nodiscard]] auto Transpose(E &&expression) {
+  return MatrixTranspose<ExpressionOperandT<E>>(std::forward<E>(expression));
+}
+
+template <class L, class R, EnableIfMatrixExpression<L> = 0,
+          EnableIfMatrixExpression<R> = 0>
+[[nodiscard]] auto Hadamard(L &&lhs, R &&rhs) {
+  return MatrixBinary<ExpressionOperandT<L>, ExpressionOperandT<R>,
+                      std::multiplies<>>(std::forward<L>(lhs),
+                                         std::forward<R>(rhs), {});
+}
+
+template <class L, class R, EnableIfMatrixExpression<L> = 0,
+          EnableIfMatrixExpression<R> = 0>
+[[nodiscard]] auto operator+(L &&lhs, R &&rhs) {
+  return MatrixBinary<ExpressionOperandT<L>, ExpressionOperandT<R>,
+                      std::plus<>>(std::forward<L>(lhs), std::forward<R>(rhs),
+                                   {});
+}
+
+template <class L, class R, EnableIfMatrixExpression<L> = 0,
+          EnableIfMatrixExpression<R> = 0>
+[[nodiscard]] auto operator-(L &&lhs, R &&rhs) {
+  return MatrixBinary<ExpressionOperandT<L>, ExpressionOperandT<R>,
+                      std::minus<>>(std::forward<L>(lhs), std::forward<R>(rhs),
+                                    {});
+}
+
+template <class L, class R, EnableIfMatrixExpression<L> = 0,
+          EnableIfMatrixExpression<R> = 0>
+[[nodiscard]] auto operator*(L &&lhs, R &&rhs) {
+  return MatrixProduct<ExpressionOperandT<L>, ExpressionOperandT<R>>(
+      std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class V, class E, std::enable_if_t<std::is_arithmetic_v<V>, int> = 0,
+          EnableIfMatrixExpression<E> = 0>
+[[nodiscard]] auto operator*(const V value, E &&expression) {
+  using T = typename std::decay_t<E>::value_type;
+  return Apply(std::forward<E>(expression),
+               MatrixScale<T>{static_cast<T>(value)});
+}
+
+template <class E, class V, EnableIfMatrixExpression<E> = 0,
+          std::enable_if_t<std::is_arithmetic_v<V>, int> = 0>
+[[nodiscard]] auto operator*(E &&expression, const V value) {
+  return value * std::forward<E>(expression);
+}
+
 template <class T>
 std::ostream &operator<<(std::ostream &out, const Matrix<T> matrix) {
   if (out.bad()) {
@@ -110,6 +409,16 @@ Matrix<T>::Matrix(const std::size_t rows, const std::size_t columns)
   AllocMemory();
 }
 
+template <class T>
+Matrix<T>::Matrix(const std::size_t rows, const std::size_t columns,
+                  std::pmr::memory_resource *resource)
+    : rows_(rows), columns_(columns), resource_(resource) {
+  if (!rows_ || !columns_) {
+    throw std::invalid_argument("Arguments cannot be zero");
+  }
+  AllocMemory();
+}
+
 template <class T>
 Matrix<T>::Matrix(const Matrix<T> &other)
     : rows_(other.rows_), columns_(other.columns_) {
@@ -121,14 +430,23 @@ template <class T>
 Matrix<T>::Matrix(Matrix<T> &&other)
     : rows_(std::exchange(other.rows_, 3)),
       columns_(std::exchange(other.columns_, 3)),
+      resource_(other.resource_),
       matrix_(std::exchange(other.matrix_, nullptr)) {
   other.AllocMemory();
 }
 
+template <class T>
+template <class E>
+Matrix<T>::Matrix(const MatrixExpression<E> &expression)
+    : rows_(expression.Self().GetRows()),
+      columns_(expression.Self().GetColumns()) {
+  AllocMemory();
+  Assign(expression.Self());
+}
+
 template <class T>
 Matrix<T>::~Matrix() {
-  delete[] matrix_[0];
-  delete[] matrix_;
+  FreeMemory();
 }
 
 template <class T>
@@ -148,7 +466,7 @@ std::size_t Matrix<T>::Size() const noexcept {
 
 template <class T>
 void Matrix<T>::Set(const std::size_t rows, const std::size_t columns) {
-  Matrix<T> temp(rows, columns);
+  Matrix<T> temp(rows, columns, resource_);
   for (std::size_t row = 0; row < std::min(rows_, rows); ++row) {
     for (std::size_t column = 0; column < std::min(columns_, columns);
          ++column) {
@@ -177,6 +495,35 @@ T &Matrix<T>::operator()(const std::size_t rows,
   return matrix_[rows][columns];
 }
 
+template <class T>
+T Matrix<T>::At(const std::size_t row,
+                const std::size_t column) const noexcept {
+  return matrix_[row][column];
+}
+
+template <class T>
+bool Matrix<T>::Refers(const void *target) const noexcept {
+  return this == target;
+}
+
+template <class T>
+bool Matrix<T>::Aliases(const void *) const noexcept {
+  return false;
+}
+
+template <class T>
+void Matrix<T>::Swap(Matrix<T> &other) noexcept {
+  std::swap(rows_, other.rows_);
+  std::swap(columns_, other.columns_);
+  std::swap(resource_, other.resource_);
+  std::swap(matrix_, other.matrix_);
+}
+
+template <class T>
+std::pmr::memory_resource *Matrix<T>::GetResource() const noexcept {
+  return resource_;
+}
+
 template <class T>
 Matrix<T> &Matrix<T>::operator+=(const Matrix<T> &other) {
   return SumMatrix(other), *this;
@@ -199,17 +546,26 @@ Matrix<T> &Matrix<T>::operator-=(const Matrix<T> &other) {
 
 template <class T>
 Matrix<T> &Matrix<T>::operator=(const Matrix<T> &other) {
-  if (this != &other) {
-    Matrix<T> temp(other);
-    *this = std::move(temp);
+  if (this == &other) {
+    return *this;
+  }
+  if (rows_ == other.rows_ && columns_ == other.columns_) {
+    std::copy_n(other.matrix_[0], Size(), matrix_[0]);
+  } else {
+    Matrix<T> temp(other.rows_, other.columns_, resource_);
+    std::copy_n(other.matrix_[0], temp.Size(), temp.matrix_[0]);
+    Swap(temp);
   }
   return *this;
 }
 
 template <class T>
 Matrix<T> &Matrix<T>::operator=(Matrix<T> &&other) {
+  if (this != &other && !resource_->is_equal(*other.resource_)) {
+    return *this = static_cast<const Matrix<T> &>(other);
+  }
   if (this != &other) {
-    this->~Matrix();
+    FreeMemory();
     rows_ = std::exchange(other.rows_, 3);
     columns_ = std::exchange(other.columns_, 3);
     matrix_ = std::exchange(other.matrix_, nullptr);
@@ -218,6 +574,33 @@ Matrix<T> &Matrix<T>::operator=(Matrix<T> &&other) {
   return *this;
 }
 
+template <class T>
+template <class E>
+Matrix<T> &Matrix<T>::operator=(const MatrixExpression<E> &expression) {
+  const E &source = expression.Self();
+  if (rows_ != source.GetRows() || columns_ != source.GetColumns() ||
+      source.Aliases(this)) {
+    Matrix<T> temp(source.GetRows(), source.GetColumns(), resource_);
+    temp.Assign(source);
+    Swap(temp);
+  } else {
+    Assign(source);
+  }
+  return *this;
+}
+
+template <class T>
+template <class E>
+Matrix<T> &Matrix<T>::operator+=(const MatrixExpression<E> &expression) {
+  return *this = *this + expression.Self();
+}
+
+template <class T>
+template <class E>
+Matrix<T> &Matrix<T>::operator-=(const MatrixExpression<E> &expression) {
+  return *this = *this - expression.Self();
+}
+
 template <class T>
 bool Matrix<T>::EqMatrix(const Matrix<T> &other) const {
   if (rows_ != other.rows_ || columns_ != other.columns_) {
@@ -256,64 +639,12 @@ void Matrix<T>::MulNumber(const T value) {
 
 template <class T>
 void Matrix<T>::MulMatrix(const Matrix<T> &other) {
-  if (columns_ != other.rows_) {
-    throw std::invalid_argument(
-        "Wrong matrix, different Size first matrix "
-        "columns and second matrix rows");
-  }
-
-  const std::size_t d = columns_ / 2;
-  std::vector<T> rowFactor(rows_);
-  std::vector<T> colsFactor(other.columns_);
-  for (std::size_t i = 0; i < rows_; ++i) {
-    rowFactor[i] = matrix_[i][0] * matrix_[i][1];
-    for (std::size_t j = 1; j < d; ++j) {
-      const std::size_t mul = 2 * j;
-      rowFactor[i] += matrix_[i][mul] * matrix_[i][mul + 1];
-    }
-  }
-  for (std::size_t i = 0; i < other.columns_; ++i) {
-    colsFactor[i] = other(0, i) * other(1, i);
-    for (std::size_t j = 1; j < d; ++j) {
-      const std::size_t mul = 2 * j;
-      colsFactor[i] += other.matrix_[mul][i] * other.matrix_[mul + 1][i];
-    }
-  }
-
-  Matrix<T> result{rows_, other.columns_};
-
-  for (std::size_t i = 0; i < rows_; ++i) {
-    for (std::size_t j = 0; j < other.columns_; ++j) {
-      result(i, j) = -rowFactor[i] - colsFactor[j];
-      for (std::size_t k = 0; k < d; ++k) {
-        const std::size_t mul = 2 * k;
-        result.matrix_[i][j] += (matrix_[i][mul] + other.matrix_[mul + 1][j]) *
-                                (matrix_[i][mul + 1] + other.matrix_[mul][j]);
-      }
-    }
-  }
-
-  if (columns_ % 2 == 1) {
-    for (std::size_t i = 0; i < rows_; ++i) {
-      for (std::size_t j = 0; j < other.columns_; ++j) {
-        result.matrix_[i][j] +=
-            matrix_[i][columns_ - 1] * other.matrix_[columns_ - 1][j];
-      }
-    }
-  }
-
-  *this = std::move(result);
+  *this = *this * other;
 }
 
 template <class T>
 [[nodiscard]] Matrix<T> Matrix<T>::Transpose() const {
-  Matrix<T> result(columns_, rows_);
-  for (std::size_t i = 0; i < rows_; ++i) {
-    for (std::size_t j = 0; j < columns_; ++j) {
-      result(j, i) = (*this)(i, j);
-    }
-  }
-  return result;
+  return s21::Transpose(*this);
 }
 
 template <class T>
@@ -389,37 +720,40 @@ void Matrix<T>::CheckEqSize(const Matrix &other) const {
 }
 
 template <class T>
-void Matrix<T>::AllocMemory() {
-  matrix_ = new T *[rows_] {};
-  matrix_[0] = new T[Size()]{};
-  for (std::size_t index = 1; index < rows_; ++index) {
-    matrix_[index] = matrix_[index - 1] + columns_;
+template <class E>
+void Matrix<T>::Assign(const E &source) {
+  for (std::size_t i = 0; i < rows_; ++i) {
+    for (std::size_t j = 0; j < columns_; ++j) {
+      matrix_[i][j] = source.At(i, j);
+    }
   }
 }
 
 template <class T>
-[[nodiscard]] Matrix<T> operator-(Matrix<T> lhs, const Matrix<T> &rhs) {
-  return lhs -= rhs;
-}
-
-template <class T>
-[[nodiscard]] Matrix<T> operator+(Matrix<T> lhs, const Matrix<T> &rhs) {
-  return lhs += rhs;
-}
-
-template <class T>
-Matrix<T> operator*(const T value, Matrix<T> src) {
-  return src *= value;
+std::size_t Matrix<T>::DataBytes() const noexcept {
+  return (Size() * sizeof(T) + alignof(T *) - 1) / alignof(T *) * alignof(T *);
 }
 
 template <class T>
-Matrix<T> operator*(Matrix<T> src, const T value) {
-  return src *= value;
+void Matrix<T>::AllocMemory() {
+  auto *block = static_cast<std::byte *>(
+      resource_->allocate(DataBytes() + rows_ * sizeof(T *),
+                          std::max(alignof(T), alignof(T *))));
+  T *data = reinterpret_cast<T *>(block);
+  std::fill_n(data, Size(), T{});
+  matrix_ = reinterpret_cast<T **>(block + DataBytes());
+  for (std::size_t index = 0; index < rows_; ++index) {
+    matrix_[index] = data + index * columns_;
+  }
 }
 
 template <class T>
-[[nodiscard]] Matrix<T> operator*(Matrix<T> lhs, const Matrix<T> &rhs) {
-  return lhs *= rhs;
+void Matrix<T>::FreeMemory() noexcept {
+  if (matrix_) {
+    resource_->deallocate(matrix_[0], DataBytes() + rows_ * sizeof(T *),
+                          std::max(alignof(T), alignof(T *)));
+    matrix_ = nullptr;
+  }
 }
 
 template <class T>
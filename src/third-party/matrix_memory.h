@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+//! Статистика распределителя памяти матриц
+struct MatrixMemoryStats {
+  std::size_t bytes;                 //!< Занято байт сейчас
+  std::size_t peak_bytes;            //!< Максимум занятых байт
+  std::size_t allocations;           //!< Всего выделений
+  std::size_t upstream_allocations;  //!< Выделений у MatrixHeap
+  std::size_t skipped_resets;        //!< Сбросов, отложенных из-за живых матриц
+};
+
+//! Системная куча матриц с подсчетом статистики
+class MatrixHeap final : public std::pmr::memory_resource {
+ public:
+  //! Общий для всех потоков экземпляр
+  static MatrixHeap &Instance() {
+    static MatrixHeap heap;
+    return heap;
+  }
+  //! Получить статистику
+  MatrixMemoryStats GetStats() const noexcept {
+    const std::size_t allocations = allocations_.load();
+    return {bytes_.load(), peak_bytes_.load(), allocations, allocations, 0};
+  }
+
+ private:
+  MatrixHeap() = default;
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void *data = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t used = bytes_.fetch_add(bytes) + bytes;
+    for (std::size_t peak = peak_bytes_.load();
+         peak < used && !peak_bytes_.compare_exchange_weak(peak, used);) {
+    }
+    return data;
+  }
+  void do_deallocate(void *data, std::size_t bytes,
+                     std::size_t alignment) override {
+    bytes_.fetch_sub(bytes);
+    std::pmr::new_delete_resource()->deallocate(data, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  std::atomic<std::size_t> bytes_{0}, peak_bytes_{0}, allocations_{0};
+};
+
+//! Ресурс памяти, из которого создаются новые матрицы текущего потока
+inline thread_local std::pmr::memory_resource *current_matrix_resource =
+    nullptr;
+
+//! Получить ресурс памяти новых матриц текущего потока
+inline std::pmr::memory_resource *GetMatrixResource() noexcept {
+  return current_matrix_resource ? current_matrix_resource
+                                 : &MatrixHeap::Instance();
+}
+
+//! Подменить ресурс памяти новых матриц потока на время жизни объекта
+class MatrixResourceScope {
+ public:
+  /**
+   * @brief Установить ресурс памяти
+   * @param resource Ресурс памяти новых матриц
+   */
+  explicit MatrixResourceScope(std::pmr::memory_resource *resource) noexcept
+      : previous_(std::exchange(current_matrix_resource, resource)) {}
+  //! Удален конструктор копирования
+  MatrixResourceScope(const MatrixResourceScope &) = delete;
+  //! Удален оператор копирования
+  MatrixResourceScope &operator=(const MatrixResourceScope &) = delete;
+  //! Вернуть прежний ресурс памяти
+  ~MatrixResourceScope() { current_matrix_resource = previous_; }
+
+ private:
+  std::pmr::memory_resource *previous_;
+};
+
+/**
+ * @brief Монотонная арена матриц потока
+ * @details Память выдается сдвигом указателя и освобождается разом на
+ * границе шага. Если за шаг понадобилось несколько блоков, они склеиваются
+ * в один, и следующие шаги обходятся без системной кучи
+ */
+class MatrixArena final : public std::pmr::memory_resource {
+ public:
+  /**
+   * @brief Граница шага: арена потока назначается ресурсом новых матриц, в
+   * конце шага она сбрасывается
+   * @details Все матрицы, созданные внутри шага, должны быть уничтожены до
+   * его конца. Результат, который переживает шаг, создается до шага: перенос
+   * матрицы забирает и ее ресурс памяти, поэтому перенесенная из шага
+   * матрица остается в арене. Пока такая матрица жива, арена потока не
+   * сбрасывается и растет, каждый пропущенный сброс считается в
+   * skipped_resets
+   */
+  class Step {
+   public:
+    //! Назначить арену потока ресурсом новых матриц
+    Step() : arena_(Local()), scope_(&arena_) {}
+    //! Удален конструктор копирования
+    Step(const Step &) = delete;
+    //! Удален оператор копирования
+    Step &operator=(const Step &) = delete;
+    //! Вернуть прежний ресурс и сбросить арену
+    ~Step() { arena_.Reset(); }
+
+   private:
+    //! Арена потока
+    MatrixArena &arena_;
+    //! Подмена ресурса новых матриц на время шага
+    MatrixResourceScope scope_;
+  };
+  /**
+   * @brief Конструктор
+   * @param block_size Размер первого блока в байтах
+   */
+  explicit MatrixArena(std::size_t block_size = 1 << 16)
+      : MatrixArena(block_size, false) {}
+  MatrixArena(const MatrixArena &) = delete;
+  MatrixArena &operator=(const MatrixArena &) = delete;
+  ~MatrixArena() override { Release(); }
+  /**
+   * @brief Арена текущего потока
+   * @details Если при выходе потока из арены еще живут матрицы, арена и ее
+   * блоки не освобождаются, их освобождает последняя уничтоженная матрица
+   */
+  static MatrixArena &Local() {
+    thread_local Owner owner;
+    return *owner.arena;
+  }
+  /**
+   * @brief Вернуть всю память арены к началу
+   * @details Пока из арены живет хоть одна матрица, сброс откладывается до
+   * следующего шага и учитывается в статистике арены и в GetSkippedResets
+   */
+  void Reset() {
+    if (live_.load(std::memory_order_acquire) != (owned_ ? 1 : 0)) {
+      ++stats_.skipped_resets;
+      skipped_resets_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    if (blocks_.size() > 1) {
+      std::size_t total = 0;
+      for (const auto &block : blocks_) {
+        total += block.size;
+      }
+      Release();
+      AddBlock(total);
+    }
+    current_ = 0;
+    offset_ = 0;
+    stats_.bytes = 0;
+  }
+  //! Получить статистику
+  const MatrixMemoryStats &GetStats() const noexcept { return stats_; }
+  //! Получить число отложенных сбросов арен всех потоков
+  static std::size_t GetSkippedResets() noexcept {
+    return skipped_resets_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  //! Владелец арены потока, отпускает ее при выходе потока
+  struct Owner {
+    Owner() : arena(new MatrixArena(1 << 16, true)) {}
+    Owner(const Owner &) = delete;
+    Owner &operator=(const Owner &) = delete;
+    ~Owner() { arena->Unref(); }
+    MatrixArena *arena;  //!< Арена потока
+  };
+  //! Блок памяти, взятый у MatrixHeap
+  struct Block {
+    std::byte *data;   //!< Начало блока
+    std::size_t size;  //!< Размер блока в байтах
+  };
+
+  /**
+   * @brief Конструктор
+   * @param block_size Размер первого блока в байтах
+   * @param owned Принадлежит ли арена потоку: тогда поток держит ссылку в
+   * live_, и арена удаляет себя, когда ссылок не остается
+   */
+  MatrixArena(std::size_t block_size, bool owned)
+      : block_size_(block_size), owned_(owned), live_(owned ? 1 : 0) {}
+  //! Отпустить ссылку и удалить арену потока, если ссылка последняя
+  void Unref() {
+    if (live_.fetch_sub(1, std::memory_order_acq_rel) == 1 && owned_) {
+      delete this;
+    }
+  }
+  //! Выделить память сдвигом указателя, при нехватке добавить блок
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    while (current_ < blocks_.size()) {
+      const auto &block = blocks_[current_];
+      const std::size_t begin =
+          (offset_ + alignment - 1) / alignment * alignment;
+      if (begin + bytes <= block.size) {
+        offset_ = begin + bytes;
+        return Account(block.data + begin, bytes);
+      }
+      ++current_;
+      offset_ = 0;
+    }
+    const std::size_t size = std::max(
+        {block_size_, blocks_.empty() ? 0 : blocks_.back().size * 2,
+         bytes + alignment});
+    AddBlock(size);
+    current_ = blocks_.size() - 1;
+    offset_ = bytes;
+    return Account(blocks_.back().data, bytes);
+  }
+  //! Отметить освобождение, может вызываться из любого потока
+  void do_deallocate(void *, std::size_t, std::size_t) override { Unref(); }
+  //! Арена равна только самой себе
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  //! Учесть выделение в статистике
+  void *Account(std::byte *data, std::size_t bytes) {
+    live_.fetch_add(1, std::memory_order_relaxed);
+    ++stats_.allocations;
+    stats_.bytes += bytes;
+    stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.bytes);
+    return data;
+  }
+  //! Взять у MatrixHeap новый блок
+  void AddBlock(std::size_t size) {
+    blocks_.push_back({static_cast<std::byte *>(MatrixHeap::Instance().allocate(
+                           size, alignof(std::max_align_t))),
+                       size});
+    ++stats_.upstream_allocations;
+  }
+  //! Вернуть все блоки MatrixHeap
+  void Release() {
+    for (const auto &block : blocks_) {
+      MatrixHeap::Instance().deallocate(block.data, block.size,
+                                        alignof(std::max_align_t));
+    }
+    blocks_.clear();
+  }
+
+  //! Размер первого блока в байтах
+  std::size_t block_size_;
+  //! Блоки памяти
+  std::vector<Block> blocks_;
+  //! Текущий блок и смещение в нем
+  std::size_t current_ = 0, offset_ = 0;
+  //! Принадлежит ли арена потоку
+  bool owned_;
+  //! Живых матриц из арены и ссылка потока-владельца, уменьшается потоком,
+  //! уничтожающим матрицу
+  std::atomic<std::size_t> live_;
+  //! Статистика арены
+  MatrixMemoryStats stats_{};
+  //! Отложенных сбросов арен всех потоков
+  static inline std::atomic<std::size_t> skipped_resets_{0};
+};
+
+}  // namespace s21